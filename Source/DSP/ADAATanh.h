@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cmath>
+
+/**
+ * Antiderivative anti-aliasing (ADAA) for asymmetric tanh saturation
+ *
+ * Evaluates h(z) = tanh(k * z), with a separate slope k for z >= 0 and
+ * z < 0, as the divided difference of its antiderivative instead of
+ * pointwise: (H1(z0) - H1(z1)) / (z0 - z1), half a sample of delay. That
+ * continuous-time averaging suppresses the harmonics that would fold
+ * back above Nyquist.
+ *
+ * H1(z) = logcosh(k z) / k, in closed form and in double precision: the
+ * divided difference amplifies rounding by 1/dz, which float can't
+ * absorb. When the input barely moves (|dz| < tolerance) it is replaced
+ * by its limit, evaluated at the midpoint.
+ *
+ * There is no 2nd order: its closed-form H2 (a dilogarithm series) cost
+ * more than 2x IIR oversampling for less suppression.
+ *
+ * Any linear term summed with the output must see the same delay:
+ * alignLinear() runs it through the ADAA kernel of the identity,
+ * (l0 + l1) / 2.
+ *
+ * One instance per channel; audio thread only.
+ */
+class ADAATanh
+{
+public:
+    enum Order { ORDER_NONE = 0, ORDER_1 };
+
+    void setOrder(Order newOrder)
+    {
+        if (newOrder != order)
+        {
+            order = newOrder;
+            reset();
+        }
+    }
+
+    Order getOrder() const { return order; }
+
+    // Samples of delay added by an order
+    static float getDelaySamples(Order o) { return 0.5f * static_cast<float>(o); }
+
+    // Slopes for the positive and negative halves
+    void setSlopes(double positive, double negative)
+    {
+        if (positive == kPositive && negative == kNegative)
+            return;
+
+        kPositive = positive;
+        kNegative = negative;
+
+        // Re-evaluate the cached antiderivative on the new curve, so the
+        // next divided difference doesn't straddle two curves
+        h1Previous = integral1(z1);
+    }
+
+    void reset()
+    {
+        z1 = 0.0;
+        h1Previous = 0.0;
+        linear1 = 0.0f;
+    }
+
+    // tanh(k z), anti-aliased at the current order
+    inline float process(float z)
+    {
+        switch (order)
+        {
+            case ORDER_1: return processFirstOrder(z);
+            case ORDER_NONE:
+            default:      return static_cast<float>(curve(z));
+        }
+    }
+
+    // A linear term delayed to line up with process(); once per sample
+    inline float alignLinear(float linear)
+    {
+        const float aligned = order == ORDER_1 ? 0.5f * (linear + linear1) : linear;
+        linear1 = linear;
+        return aligned;
+    }
+
+    // The curve and its closed-form antiderivative
+    inline double curve(double z) const       { return std::tanh(slope(z) * z); }
+    inline double integral1(double z) const   { const double k = slope(z); return logCosh(k * z) / k; }
+
+    // log(cosh(x)) without overflow
+    static inline double logCosh(double x)
+    {
+        const double a = std::abs(x);
+        return a + std::log1p(std::exp(-2.0 * a)) - ln2;
+    }
+
+private:
+    static constexpr double ln2 = 0.69314718055994530942;
+
+    // Below this input step the divided difference is replaced by its
+    // midpoint limit (error ~ dz^2, well under float resolution)
+    static constexpr double firstOrderTolerance = 1.0e-5;
+
+    inline double slope(double z) const { return z >= 0.0 ? kPositive : kNegative; }
+
+    inline float processFirstOrder(float zf)
+    {
+        const double z = zf;
+        const double h1 = integral1(z);
+        const double dz = z - z1;
+
+        const double y = std::abs(dz) < firstOrderTolerance ? curve(0.5 * (z + z1))
+                                                            : (h1 - h1Previous) / dz;
+
+        z1 = z;
+        h1Previous = h1;
+
+        return static_cast<float>(y);
+    }
+
+    Order order = ORDER_NONE;
+    double kPositive = 1.0;
+    double kNegative = 1.0;
+
+    // Previous input and antiderivative value
+    double z1 = 0.0;
+    double h1Previous = 0.0;
+
+    // Previous linear term for alignLinear()
+    float linear1 = 0.0f;
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <utility>
+
+/**
+ * Non-owning view of a block of planar float audio
+ *
+ * The DSP modules take their audio as one of these rather than a framework
+ * buffer, so Source/DSP builds on its own (the NeveStripDSP library, no
+ * JUCE). It converts implicitly from any buffer with getArrayOfWritePointers(),
+ * getNumChannels() and getNumSamples() - juce::AudioBuffer<float> in the
+ * plugin - so those call sites pass their buffers unchanged. Other callers
+ * wrap their own channel pointers: module.process({ channels, 2, numSamples }).
+ *
+ * The channel pointer array and the audio must outlive the call.
+ */
+class AudioSpan
+{
+public:
+    AudioSpan(float* const* channelData, int numChannels, int numSamples) noexcept
+        : channels(channelData), channelCount(numChannels), sampleCount(numSamples) {}
+
+    template <typename Buffer, typename = decltype(std::declval<Buffer&>().getArrayOfWritePointers())>
+    AudioSpan(Buffer& buffer) noexcept
+        : AudioSpan(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), buffer.getNumSamples()) {}
+
+    int getNumChannels() const noexcept { return channelCount; }
+    int getNumSamples() const noexcept { return sampleCount; }
+    float* getWritePointer(int channel) const noexcept { return channels[channel]; }
+
+private:
+    float* const* channels;
+    int channelCount;
+    int sampleCount;
+};
@@ -2,6 +2,9 @@
 
 #include <cmath>
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include "SIMDTypes.h"
 
 namespace DSPUtils
 {
@@ -15,6 +18,102 @@ namespace DSPUtils
         return std::pow(10.0f, dB / 20.0f);
     }
 
+    // dB per log2 unit (20 * log10(2))
+    constexpr float decibelsPerLog2 = 6.02059991f;
+
+    // Fast log2 for positive, normal floats (callers clamp away zero)
+    // Exponent from the float bits + degree-5 polynomial on the mantissa.
+    // Max abs error 1.7e-5 (log2 units) = 1.0e-4 dB. Branch-free, vectorises.
+    inline float fastLog2(float x)
+    {
+        int32_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+
+        const float exponent = static_cast<float>(((bits >> 23) & 255) - 127);
+
+        bits = (bits & 0x007FFFFF) | 0x3F800000;  // mantissa in [1, 2)
+        float mantissa;
+        std::memcpy(&mantissa, &bits, sizeof(mantissa));
+
+        const float t = mantissa - 1.0f;
+        const float poly = 1.65146709e-5f + t * (1.44149241f + t * (-0.706486449f
+                         + t * (0.409470299f + t * (-0.187488605f + t * 0.0430049578f))));
+
+        return exponent + poly;
+    }
+
+    // Fast 2^x, input clamped to [-126, 126]
+    // Integer part into the exponent bits + degree-4 polynomial on the fraction.
+    // Max relative error 3.5e-6 = 3.0e-5 dB. Branch-free, vectorises.
+    inline float fastExp2(float x)
+    {
+        x = std::min(std::max(x, -126.0f), 126.0f);
+
+        // floor without a libm call
+        int32_t whole = static_cast<int32_t>(x);
+        whole -= (x < static_cast<float>(whole)) ? 1 : 0;
+
+        const float t = x - static_cast<float>(whole);
+        const float poly = 1.00000349f + t * (0.692972922f + t * (0.241604357f
+                         + t * (0.0517449978f + t * 0.0136703095f)));
+
+        int32_t bits;
+        std::memcpy(&bits, &poly, sizeof(bits));
+        bits += whole * (1 << 23);
+
+        float result;
+        std::memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
+
+    // Four-lane fastLog2 / fastExp2 (same polynomials and error bounds)
+    inline SIMD::Float4 fastLog2(SIMD::Float4 x)
+    {
+        using SIMD::Float4;
+
+        const Float4 t = Float4::mantissa(x) - Float4::broadcast(1.0f);
+        Float4 poly = Float4::broadcast(0.0430049578f);
+        poly = Float4::broadcast(-0.187488605f) + t * poly;
+        poly = Float4::broadcast(0.409470299f) + t * poly;
+        poly = Float4::broadcast(-0.706486449f) + t * poly;
+        poly = Float4::broadcast(1.44149241f) + t * poly;
+        poly = Float4::broadcast(1.65146709e-5f) + t * poly;
+
+        return Float4::exponent(x) + poly;
+    }
+
+    inline SIMD::Float4 fastExp2(SIMD::Float4 x)
+    {
+        using SIMD::Float4;
+
+        x = min(max(x, Float4::broadcast(-126.0f)), Float4::broadcast(126.0f));
+
+        const Float4 whole = Float4::floor(x);
+        const Float4 t = x - whole;
+        Float4 poly = Float4::broadcast(0.0136703095f);
+        poly = Float4::broadcast(0.0517449978f) + t * poly;
+        poly = Float4::broadcast(0.241604357f) + t * poly;
+        poly = Float4::broadcast(0.692972922f) + t * poly;
+        poly = Float4::broadcast(1.00000349f) + t * poly;
+
+        return Float4::scaleByPowerOfTwo(poly, whole);
+    }
+
+    // Fast tanh from fastExp2: 1 - 2 / (e^2x + 1). Abs error under 2e-6;
+    // saturates cleanly to +/-1 through the exp2 clamp. Branch-free.
+    inline float fastTanh(float x)
+    {
+        return 1.0f - 2.0f / (fastExp2(2.88539008f * x) + 1.0f);     // 2 / ln 2
+    }
+
+    inline SIMD::Float4 fastTanh(SIMD::Float4 x)
+    {
+        using SIMD::Float4;
+
+        const Float4 one = Float4::broadcast(1.0f);
+        return one - Float4::broadcast(2.0f) / (fastExp2(x * Float4::broadcast(2.88539008f)) + one);
+    }
+
     inline float mapRange(float value, float inMin, float inMax, float outMin, float outMax)
     {
         return outMin + (outMax - outMin) * (value - inMin) / (inMax - inMin);
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Wait-free single-producer / single-consumer ring of small frames
+ *
+ * The audio thread pushes one frame per block; a UI thread pops them all
+ * at its own rate. Each side only ever stores its own index and reads the
+ * other's, so neither side can be blocked or made to retry. A full ring
+ * drops the newest frame and counts it instead of waiting.
+ *
+ * - push(): the producer thread only
+ * - pop()/getNumDropped(): the consumer thread only
+ */
+template <typename T, int capacity>
+class FrameQueue
+{
+public:
+    static_assert((capacity & (capacity - 1)) == 0, "Capacity must be a power of two");
+
+    // Producer: false (frame dropped) when the consumer has fallen a full ring behind
+    bool push(const T& frame)
+    {
+        const uint32_t write = writeIndex.load(std::memory_order_relaxed);
+
+        if (write - readIndex.load(std::memory_order_acquire) == static_cast<uint32_t>(capacity))
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        slots[write & mask] = frame;
+        writeIndex.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: oldest frame first; false when empty
+    bool pop(T& frame)
+    {
+        const uint32_t read = readIndex.load(std::memory_order_relaxed);
+
+        if (read == writeIndex.load(std::memory_order_acquire))
+            return false;
+
+        frame = slots[read & mask];
+        readIndex.store(read + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: frames lost to a full ring since the last call
+    uint32_t getNumDropped() { return dropped.exchange(0, std::memory_order_relaxed); }
+
+private:
+    static constexpr uint32_t mask = static_cast<uint32_t>(capacity - 1);
+
+    T slots[capacity] {};
+
+    // Free-running counters, kept on separate cache lines
+    alignas(64) std::atomic<uint32_t> writeIndex { 0 };
+    alignas(64) std::atomic<uint32_t> readIndex { 0 };
+    std::atomic<uint32_t> dropped { 0 };
+};
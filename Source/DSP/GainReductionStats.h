@@ -0,0 +1,51 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+
+// Gain reduction over one block, dB (positive = reducing)
+struct GainReductionStats
+{
+    float minimum = 0.0f;      // Shallowest
+    float maximum = 0.0f;      // Deepest
+    float mean = 0.0f;
+};
+
+/**
+ * One block's GainReductionStats, published by the audio thread as a
+ * single 64-bit word so any number of readers on any thread get a
+ * consistent set without locks: three 21-bit fields of 0.001 dB
+ * (0 to 2097 dB, clamped).
+ */
+class AtomicGainReductionStats
+{
+public:
+    void store(const GainReductionStats& stats)
+    {
+        packed.store(pack(stats.minimum) | (pack(stats.maximum) << fieldBits) | (pack(stats.mean) << (2 * fieldBits)),
+                     std::memory_order_relaxed);
+    }
+
+    GainReductionStats load() const
+    {
+        const uint64_t word = packed.load(std::memory_order_relaxed);
+        return { unpack(word), unpack(word >> fieldBits), unpack(word >> (2 * fieldBits)) };
+    }
+
+private:
+    static constexpr int fieldBits = 21;
+    static constexpr uint64_t fieldMask = (uint64_t(1) << fieldBits) - 1;
+    static constexpr float stepsPerDb = 1000.0f;
+
+    static uint64_t pack(float db)
+    {
+        const float steps = std::min(std::max(db * stepsPerDb + 0.5f, 0.0f), static_cast<float>(fieldMask));
+        return static_cast<uint64_t>(steps);
+    }
+
+    static float unpack(uint64_t field) { return static_cast<float>(field & fieldMask) / stepsPerDb; }
+
+    std::atomic<uint64_t> packed { 0 };
+};
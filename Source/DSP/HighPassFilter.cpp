@@ -1,5 +1,6 @@
 #include "HighPassFilter.h"
 #include "DSPUtils.h"
+#include "SharedTableCache.h"
 
 constexpr float HighPassFilter::frequencies[5];
 
@@ -10,14 +11,14 @@ HighPassFilter::HighPassFilter()
 void HighPassFilter::prepare(double sampleRate, int /*samplesPerBlock*/)
 {
     currentSampleRate = sampleRate;
+    coefficientTable = SharedTableCache<CoefficientTable>::get(sampleRate, buildCoefficientTable);
     updateCoefficients();
     reset();
 }
 
 void HighPassFilter::reset()
 {
-    x1L = x2L = y1L = y2L = 0.0f;
-    x1R = x2R = y1R = y2R = 0.0f;
+    filter.reset();
 }
 
 void HighPassFilter::setFrequency(int freqIndex)
@@ -30,26 +31,28 @@ void HighPassFilter::setFrequency(int freqIndex)
     updateCoefficients();
 }
 
-void HighPassFilter::updateCoefficients()
+void HighPassFilter::buildCoefficientTable(CoefficientTable& table, double sampleRate)
 {
-    if (currentFreq == HPF_OFF || cutoffHz <= 0.0f)
+    // Index 0 (Off) stays at the default pass-through coefficients
+    for (int i = 1; i < 5; ++i)
     {
-        // Pass-through (no filtering)
-        b0 = 1.0f;
-        b1 = 0.0f;
-        b2 = 0.0f;
-        a1 = 0.0f;
-        a2 = 0.0f;
-        return;
+        // Q of 0.707 for Butterworth response (flat passband)
+        float q = 0.707f;
+
+        auto& c = table.coefficients[i];
+        DSPUtils::calculateHighPass(frequencies[i], q, sampleRate, c.b0, c.b1, c.b2, c.a1, c.a2);
     }
+}
 
-    // Q of 0.707 for Butterworth response (flat passband)
-    float q = 0.707f;
+void HighPassFilter::updateCoefficients()
+{
+    if (coefficientTable == nullptr)
+        return;
 
-    DSPUtils::calculateHighPass(cutoffHz, q, currentSampleRate, b0, b1, b2, a1, a2);
+    filter.setCoefficients(coefficientTable->coefficients[currentFreq]);
 }
 
-void HighPassFilter::process(juce::AudioBuffer<float>& buffer)
+void HighPassFilter::process(AudioSpan buffer)
 {
     if (currentFreq == HPF_OFF)
         return;
@@ -60,36 +63,8 @@ void HighPassFilter::process(juce::AudioBuffer<float>& buffer)
     if (numChannels == 0)
         return;
 
-    // Process left channel
     float* left = buffer.getWritePointer(0);
-    for (int i = 0; i < numSamples; ++i)
-    {
-        float x0 = left[i];
-        float y0 = b0 * x0 + b1 * x1L + b2 * x2L - a1 * y1L - a2 * y2L;
+    float* right = numChannels > 1 ? buffer.getWritePointer(1) : nullptr;
 
-        x2L = x1L;
-        x1L = x0;
-        y2L = y1L;
-        y1L = y0;
-
-        left[i] = y0;
-    }
-
-    // Process right channel if stereo
-    if (numChannels > 1)
-    {
-        float* right = buffer.getWritePointer(1);
-        for (int i = 0; i < numSamples; ++i)
-        {
-            float x0 = right[i];
-            float y0 = b0 * x0 + b1 * x1R + b2 * x2R - a1 * y1R - a2 * y2R;
-
-            x2R = x1R;
-            x1R = x0;
-            y2R = y1R;
-            y1R = y0;
-
-            right[i] = y0;
-        }
-    }
+    filter.process(left, right, numSamples);
 }
@@ -1,6 +1,8 @@
 #pragma once
 
-#include <JuceHeader.h>
+#include "AudioSpan.h"
+#include "StereoBiquad.h"
+#include <memory>
 
 /**
  * Neve-style High Pass Filter
@@ -9,6 +11,8 @@
  * Off, 50Hz, 80Hz, 160Hz, 300Hz
  *
  * Uses 12dB/octave slope (2-pole) for smooth, musical filtering
+ * Both channels run through one StereoBiquad (L/R in SIMD lanes)
+ * Coefficients for every step come from a table shared across instances
  */
 class HighPassFilter
 {
@@ -25,30 +29,31 @@ public:
     HighPassFilter();
 
     void prepare(double sampleRate, int samplesPerBlock);
-    void process(juce::AudioBuffer<float>& buffer);
+    void process(AudioSpan buffer);
     void reset();
 
     // Set frequency (0=Off, 1=50Hz, 2=80Hz, 3=160Hz, 4=300Hz)
     void setFrequency(int freqIndex);
 
+    // All stepped coefficient sets for one sample rate
+    struct CoefficientTable
+    {
+        BiquadCoefficients coefficients[5];
+    };
+
 private:
     void updateCoefficients();
+    static void buildCoefficientTable(CoefficientTable& table, double sampleRate);
 
     // Parameters
     Frequency currentFreq = HPF_OFF;
     float cutoffHz = 0.0f;
 
-    // Biquad coefficients
-    float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f;
-    float a1 = 0.0f, a2 = 0.0f;
-
-    // Biquad state (2 channels)
-    float x1L = 0.0f, x2L = 0.0f;
-    float y1L = 0.0f, y2L = 0.0f;
-    float x1R = 0.0f, x2R = 0.0f;
-    float y1R = 0.0f, y2R = 0.0f;
+    // Stereo biquad (coefficients + interleaved L/R state)
+    StereoBiquad filter;
 
     double currentSampleRate = 44100.0;
+    std::shared_ptr<const CoefficientTable> coefficientTable;
 
     // Frequency lookup table
     static constexpr float frequencies[5] = { 0.0f, 50.0f, 80.0f, 160.0f, 300.0f };
@@ -0,0 +1,244 @@
+#include "LoudnessMeter.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+void LoudnessMeter::prepare(double sampleRate, int /*samplesPerBlock*/)
+{
+    constexpr double pi = 3.14159265358979323846;
+
+    // Pre-filter (head-related high shelf), BS.1770 analog prototype
+    // re-matched for this rate
+    {
+        const double f0 = 1681.974450955533;
+        const double gainDb = 3.999843853973347;
+        const double q = 0.7071752369554196;
+
+        const double k = std::tan(pi * f0 / sampleRate);
+        const double vh = std::pow(10.0, gainDb / 20.0);
+        const double vb = std::pow(vh, 0.4996667741545416);
+        const double a0 = 1.0 + k / q + k * k;
+
+        preFilter.setCoefficients(static_cast<float>((vh + vb * k / q + k * k) / a0),
+                                  static_cast<float>(2.0 * (k * k - vh) / a0),
+                                  static_cast<float>((vh - vb * k / q + k * k) / a0),
+                                  static_cast<float>(2.0 * (k * k - 1.0) / a0),
+                                  static_cast<float>((1.0 - k / q + k * k) / a0));
+    }
+
+    // RLB weighting (high-pass)
+    {
+        const double f0 = 38.13547087602444;
+        const double q = 0.5003270373238773;
+
+        const double k = std::tan(pi * f0 / sampleRate);
+        const double a0 = 1.0 + k / q + k * k;
+
+        rlbFilter.setCoefficients(1.0f, -2.0f, 1.0f,
+                                  static_cast<float>(2.0 * (k * k - 1.0) / a0),
+                                  static_cast<float>((1.0 - k / q + k * k) / a0));
+    }
+
+    subBlockLength = std::max(1, static_cast<int>(std::lround(0.1 * sampleRate)));
+    reset();
+}
+
+void LoudnessMeter::reset()
+{
+    preFilter.reset();
+    rlbFilter.reset();
+
+    subBlockPosition = 0;
+    subBlockSum = SIMD::Float2::broadcast(0.0f);
+
+    std::fill(std::begin(ring), std::end(ring), 0.0);
+    ringPosition = 0;
+    subBlocksSeen = 0;
+    momentarySum = 0.0;
+    shortTermSum = 0.0;
+
+    integratedHistogram.clear();
+    rangeHistogram.clear();
+
+    momentary.store(silenceLufs, std::memory_order_relaxed);
+    shortTerm.store(silenceLufs, std::memory_order_relaxed);
+    integrated.store(silenceLufs, std::memory_order_relaxed);
+    loudnessRange.store(0.0f, std::memory_order_relaxed);
+}
+
+void LoudnessMeter::process(const float* left, const float* right, int numSamples)
+{
+    using SIMD::Float2;
+
+    if (resetRequested.exchange(false, std::memory_order_relaxed))
+        reset();
+
+    // Mono runs in the left lane; the right lane is dropped at the sub-block end
+    stereo = right != nullptr;
+    if (right == nullptr)
+        right = left;
+
+    int i = 0;
+    while (i < numSamples)
+    {
+        const int n = std::min(numSamples - i, subBlockLength - subBlockPosition);
+        // Locals, so the recursion stays in registers
+        StereoBiquad pre = preFilter;
+        StereoBiquad rlb = rlbFilter;
+        Float2 sum = subBlockSum;
+
+        for (int end = i + n; i < end; ++i)
+        {
+            const Float2 weighted = rlb.processSample(pre.processSample(Float2::load(left + i, right + i)));
+            sum = sum + weighted * weighted;
+        }
+
+        preFilter = pre;
+        rlbFilter = rlb;
+        subBlockSum = sum;
+        subBlockPosition += n;
+
+        if (subBlockPosition == subBlockLength)
+            finishSubBlock();
+    }
+}
+
+void LoudnessMeter::finishSubBlock()
+{
+    // Channel weights are 1 for left and right
+    const double energy = static_cast<double>(subBlockSum.left())
+                        + (stereo ? static_cast<double>(subBlockSum.right()) : 0.0);
+    const double meanSquare = energy / static_cast<double>(subBlockLength);
+
+    subBlockSum = SIMD::Float2::broadcast(0.0f);
+    subBlockPosition = 0;
+
+    // Slide both windows by one sub-block
+    const int leavingMomentary = (ringPosition + shortTermSubBlocks - momentarySubBlocks) % shortTermSubBlocks;
+    momentarySum += meanSquare - ring[leavingMomentary];
+    shortTermSum += meanSquare - ring[ringPosition];
+
+    ring[ringPosition] = meanSquare;
+    ringPosition = ringPosition + 1 == shortTermSubBlocks ? 0 : ringPosition + 1;
+
+    // Running sums only ever lose precision; clamp the rounding residue of silence
+    momentarySum = std::max(momentarySum, 0.0);
+    shortTermSum = std::max(shortTermSum, 0.0);
+
+    subBlocksSeen = std::min(subBlocksSeen + 1, shortTermSubBlocks);
+
+    const double momentaryMeanSquare = momentarySum / momentarySubBlocks;
+    const double shortTermMeanSquare = shortTermSum / shortTermSubBlocks;
+
+    const float momentaryLufs = meanSquareToLufs(momentaryMeanSquare);
+    const float shortTermLufs = meanSquareToLufs(shortTermMeanSquare);
+
+    // Gating blocks: 400 ms at 75% overlap for integrated, 3 s at 10 Hz for LRA
+    if (subBlocksSeen >= momentarySubBlocks)
+    {
+        integratedHistogram.add(momentaryMeanSquare, momentaryLufs);
+        integrated.store(computeIntegrated(), std::memory_order_relaxed);
+    }
+
+    if (subBlocksSeen >= shortTermSubBlocks)
+    {
+        rangeHistogram.add(shortTermMeanSquare, shortTermLufs);
+        loudnessRange.store(computeLoudnessRange(), std::memory_order_relaxed);
+    }
+
+    momentary.store(momentaryLufs, std::memory_order_relaxed);
+    shortTerm.store(shortTermLufs, std::memory_order_relaxed);
+}
+
+float LoudnessMeter::computeIntegrated() const
+{
+    const auto& h = integratedHistogram;
+
+    if (h.count == 0)
+        return silenceLufs;
+
+    // Relative gate 10 LU below the absolute-gated loudness
+    const int first = Histogram::firstBinAbove(meanSquareToLufs(h.totalMeanSquare()) - 10.0f);
+
+    uint64_t count = 0;
+    double energy = 0.0;
+    for (int bin = first; bin < Histogram::numBins; ++bin)
+    {
+        count += h.counts[bin];
+        energy += h.energies[bin];
+    }
+
+    return count > 0 ? meanSquareToLufs(energy / static_cast<double>(count)) : silenceLufs;
+}
+
+float LoudnessMeter::computeLoudnessRange() const
+{
+    const auto& h = rangeHistogram;
+
+    if (h.count == 0)
+        return 0.0f;
+
+    // Relative gate 20 LU below, then the 10th to 95th percentile spread
+    const int first = Histogram::firstBinAbove(meanSquareToLufs(h.totalMeanSquare()) - 20.0f);
+
+    uint64_t count = 0;
+    for (int bin = first; bin < Histogram::numBins; ++bin)
+        count += h.counts[bin];
+
+    if (count == 0)
+        return 0.0f;
+
+    const uint64_t lowRank = count / 10;
+    const uint64_t highRank = (count * 95) / 100;
+
+    int lowBin = -1;
+    int highBin = first;
+    uint64_t seen = 0;
+
+    for (int bin = first; bin < Histogram::numBins; ++bin)
+    {
+        seen += h.counts[bin];
+        if (lowBin < 0 && seen > lowRank)
+            lowBin = bin;
+        if (seen > highRank)
+        {
+            highBin = bin;
+            break;
+        }
+    }
+
+    return Histogram::binCentre(highBin) - Histogram::binCentre(std::max(lowBin, first));
+}
+
+float LoudnessMeter::meanSquareToLufs(double meanSquare)
+{
+    return meanSquare > 1.0e-10 ? static_cast<float>(-0.691 + 10.0 * std::log10(meanSquare)) : silenceLufs;
+}
+
+void LoudnessMeter::Histogram::clear()
+{
+    std::fill(std::begin(counts), std::end(counts), 0u);
+    std::fill(std::begin(energies), std::end(energies), 0.0);
+    count = 0;
+    energy = 0.0;
+}
+
+void LoudnessMeter::Histogram::add(double meanSquare, float lufs)
+{
+    // Absolute gate
+    if (lufs <= minimumLufs)
+        return;
+
+    const int bin = std::min(numBins - 1, static_cast<int>((lufs - minimumLufs) * binsPerLu));
+    ++counts[bin];
+    energies[bin] += meanSquare;
+
+    ++count;
+    energy += meanSquare;
+}
+
+int LoudnessMeter::Histogram::firstBinAbove(float gateLufs)
+{
+    const float position = (gateLufs - minimumLufs) * binsPerLu - 0.5f;
+    return std::clamp(static_cast<int>(std::ceil(position)), 0, numBins);
+}
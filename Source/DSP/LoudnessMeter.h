@@ -0,0 +1,105 @@
+#pragma once
+
+#include "StereoBiquad.h"
+#include <atomic>
+#include <cstdint>
+
+/**
+ * ITU-R BS.1770 / EBU R128 Loudness Meter
+ *
+ * - K-weighting: pre-filter shelf + RLB high-pass, one StereoBiquad each
+ *   (L/R in SIMD lanes)
+ * - Mean square accumulated per 100 ms sub-block into a ring of the last
+ *   30 sub-blocks; momentary (400 ms) and short-term (3 s) windows are
+ *   running sums over that ring, O(1) per sub-block
+ * - Integrated loudness and loudness range (EBU Tech 3342) gate through
+ *   0.1 LU histograms that keep counts and energies per bin, so the gates
+ *   move without rescanning history; a result costs one pass over the
+ *   bins, ten times a second
+ *
+ * Results are in LUFS (LU for the range), -100 when there is nothing to
+ * measure yet.
+ *
+ * Threading: process() and reset() on one thread at a time (the processor
+ * feeds it from a FIFO off the audio thread); the getters and
+ * requestReset() from any thread.
+ */
+class LoudnessMeter
+{
+public:
+    static constexpr float silenceLufs = -100.0f;
+
+    void prepare(double sampleRate, int samplesPerBlock);
+
+    // Measure a block; right may be nullptr for mono
+    void process(const float* left, const float* right, int numSamples);
+    void reset();
+
+    // Start a new integrated / LRA measurement at the next process()
+    void requestReset() { resetRequested.store(true, std::memory_order_relaxed); }
+
+    float getMomentary() const       { return momentary.load(std::memory_order_relaxed); }
+    float getShortTerm() const       { return shortTerm.load(std::memory_order_relaxed); }
+    float getIntegrated() const      { return integrated.load(std::memory_order_relaxed); }
+    float getLoudnessRange() const   { return loudnessRange.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr int momentarySubBlocks = 4;      // 400 ms
+    static constexpr int shortTermSubBlocks = 30;     // 3 s
+
+    // Gating histogram, 0.1 LU bins from the absolute gate up
+    struct Histogram
+    {
+        static constexpr float minimumLufs = -70.0f;
+        static constexpr float binsPerLu = 10.0f;
+        static constexpr int numBins = 800;            // -70 to +10 LUFS
+
+        void clear();
+        void add(double meanSquare, float lufs);
+
+        // Mean square of all blocks above the absolute gate
+        double totalMeanSquare() const { return count > 0 ? energy / static_cast<double>(count) : 0.0; }
+
+        // First bin whose centre lies at or above a gate
+        static int firstBinAbove(float gateLufs);
+        static float binCentre(int bin) { return minimumLufs + (static_cast<float>(bin) + 0.5f) / binsPerLu; }
+
+        uint32_t counts[numBins] {};
+        double energies[numBins] {};
+        uint64_t count = 0;
+        double energy = 0.0;
+    };
+
+    // A sub-block is complete: update the windows, gates and results
+    void finishSubBlock();
+
+    float computeIntegrated() const;
+    float computeLoudnessRange() const;
+
+    static float meanSquareToLufs(double meanSquare);
+
+    StereoBiquad preFilter;
+    StereoBiquad rlbFilter;
+
+    bool stereo = true;
+    int subBlockLength = 4800;
+    int subBlockPosition = 0;
+    SIMD::Float2 subBlockSum = SIMD::Float2::broadcast(0.0f);
+
+    // Last shortTermSubBlocks mean squares and their running window sums
+    double ring[shortTermSubBlocks] {};
+    int ringPosition = 0;
+    int subBlocksSeen = 0;
+    double momentarySum = 0.0;
+    double shortTermSum = 0.0;
+
+    Histogram integratedHistogram;
+    Histogram rangeHistogram;
+
+    std::atomic<bool> resetRequested { false };
+
+    std::atomic<float> momentary { silenceLufs };
+    std::atomic<float> shortTerm { silenceLufs };
+    std::atomic<float> integrated { silenceLufs };
+    std::atomic<float> loudnessRange { 0.0f };
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+/**
+ * Meter ballistics driven by per-block level frames
+ *
+ * Each frame advances a meter by the frame's own duration (its input is
+ * held constant over it), so the reading does not depend on how blocks
+ * line up with UI repaints and nothing between two repaints is lost.
+ *
+ * - VolumeUnit: IEC 60268-17 VU on the block RMS; critically damped
+ *   second order (two equal one-poles) reaching 99% of a step in 300 ms
+ * - PeakProgramme: quasi-peak of the block peaks (IEC 60268-10 Type I):
+ *   5 ms integration, then a fall of 20 dB in 1.7 s. With no integration
+ *   time it is a plain peak-hold with that fall, as used for GR
+ *
+ * Levels are linear. Not thread-safe; the UI thread owns these.
+ */
+namespace MeterBallistics
+{
+    class VolumeUnit
+    {
+    public:
+        void reset() { stage1 = stage2 = 0.0f; }
+
+        void advance(float rms, double seconds)
+        {
+            // 1 - (1 + t / tau) e^(-t / tau) = 0.99 at t = 6.638 tau
+            constexpr double timeConstant = 0.3 / 6.638;
+            const float coeff = static_cast<float>(1.0 - std::exp(-seconds / timeConstant));
+
+            stage1 += coeff * (rms - stage1);
+            stage2 += coeff * (stage1 - stage2);
+        }
+
+        float getLevel() const { return stage2; }
+
+    private:
+        float stage1 = 0.0f;
+        float stage2 = 0.0f;
+    };
+
+    class PeakProgramme
+    {
+    public:
+        // A 5 ms burst reads 2 dB low: 1 - e^(-5 / tau) = 10^(-2 / 20)
+        static constexpr double typeOneIntegrationSeconds = 0.005 / 1.5805;
+
+        explicit PeakProgramme(double integrationSeconds = typeOneIntegrationSeconds)
+            : integration(integrationSeconds) {}
+
+        void reset() { level = 0.0f; }
+
+        void advance(float peak, double seconds)
+        {
+            // 20 dB in 1.7 s
+            constexpr double fallPerSecond = 2.302585093 / 1.7;
+
+            if (peak > level)
+                level += (integration > 0.0 ? static_cast<float>(1.0 - std::exp(-seconds / integration)) : 1.0f)
+                       * (peak - level);
+            else
+                level = std::max(peak, level * static_cast<float>(std::exp(-seconds * fallPerSecond)));
+        }
+
+        float getLevel() const { return level; }
+
+    private:
+        double integration;
+        float level = 0.0f;
+    };
+}
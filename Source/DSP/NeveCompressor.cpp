@@ -5,6 +5,58 @@ constexpr float NeveCompressor::ratios[5];
 constexpr float NeveCompressor::attackTimes[3];
 constexpr float NeveCompressor::releaseTimes[3];
 
+// Soft knee width of about 6dB (diode bridge style), in log2 units
+static constexpr float kneeWidthDb = 6.0f;
+static constexpr float kneeWidthLog2 = kneeWidthDb / DSPUtils::decibelsPerLog2;
+
+namespace
+{
+    using SIMD::Float4;
+
+    // The gain computer's transfer curve, four lanes at a time
+    struct GainCurve
+    {
+        explicit GainCurve(const NeveCompressor::Coefficients& c)
+            : thresholdLog2(Float4::broadcast(c.thresholdLog2)),
+              ratioMinusOne(Float4::broadcast(c.ratioMinusOne)),
+              fullRatioSlope(Float4::broadcast(c.fullRatioSlope)),
+              kneeEndGR(Float4::broadcast(c.kneeEndGR))
+        {
+        }
+
+        // Level over threshold in log2 units (clamped away from log of zero)
+        Float4 overThreshold(Float4 envelope) const
+        {
+            return DSPUtils::fastLog2(max(envelope, floorLevel)) - thresholdLog2;
+        }
+
+        // Gain reduction in log2 units
+        Float4 reduction(Float4 over) const
+        {
+            // Soft knee region - gradual onset (zero below threshold)
+            const Float4 kneeOver = min(max(over, zero), kneeWidth);
+            const Float4 kneeRatio = kneeOver * inverseKneeWidth;
+            const Float4 effectiveRatio = one + ratioMinusOne * kneeRatio * kneeRatio;
+            const Float4 kneeGR = kneeOver * (one - one / effectiveRatio);
+
+            // Above knee - full ratio
+            const Float4 fullGR = kneeEndGR + (over - kneeWidth) * fullRatioSlope;
+
+            return select(lessThan(over, kneeWidth), kneeGR, fullGR);
+        }
+
+        const Float4 zero = Float4::broadcast(0.0f);
+        const Float4 one = Float4::broadcast(1.0f);
+        const Float4 floorLevel = Float4::broadcast(1.0e-20f);
+        const Float4 kneeWidth = Float4::broadcast(kneeWidthLog2);
+        const Float4 inverseKneeWidth = Float4::broadcast(1.0f / kneeWidthLog2);
+        const Float4 thresholdLog2;
+        const Float4 ratioMinusOne;
+        const Float4 fullRatioSlope;
+        const Float4 kneeEndGR;
+    };
+}
+
 NeveCompressor::NeveCompressor()
 {
 }
@@ -20,208 +72,385 @@ void NeveCompressor::reset()
 {
     envelopeL = 0.0f;
     envelopeR = 0.0f;
-    currentGainReduction = 0.0f;
+    gainReductionStats.store({});
     autoReleaseEnv = 0.0f;
+    lastGainValid = false;
     scHpfStateL = 0.0f;
     scHpfStateR = 0.0f;
 }
 
 void NeveCompressor::updateCoefficients()
 {
-    ratio = ratios[ratioIndex];
-    attackMs = attackTimes[attackIndex];
+    Coefficients c;
+
+    // Gain computer works in log2 units; the curve is scale-free, so the
+    // dB formulas carry over with the knee width converted
+    const float ratio = ratios[ratioIndex];
+    c.thresholdLog2 = threshold / DSPUtils::decibelsPerLog2;
+    c.fullRatioSlope = 1.0f - 1.0f / ratio;
+    c.ratioMinusOne = ratio - 1.0f;
+    c.kneeEndGR = kneeWidthLog2 * c.fullRatioSlope * 0.25f;
 
-    if (releaseIndex < 3)
-        releaseMs = releaseTimes[releaseIndex];
-    // Auto release handled in processing
+    c.attackCoeff = DSPUtils::calculateCoefficient(currentSampleRate, attackTimes[attackIndex]);
 
-    attackCoeff = DSPUtils::calculateCoefficient(currentSampleRate, attackMs);
-    releaseCoeff = DSPUtils::calculateCoefficient(currentSampleRate, releaseMs);
-    makeupLinear = DSPUtils::decibelsToLinear(makeup);
+    // Auto release blends between a fast and a slow coefficient in processing
+    c.autoRelease = (releaseIndex == RELEASE_AUTO);
+    if (! c.autoRelease)
+        c.releaseCoeff = DSPUtils::calculateCoefficient(currentSampleRate, releaseTimes[releaseIndex]);
+    c.autoReleaseFastCoeff = DSPUtils::calculateCoefficient(currentSampleRate, 50.0f);
+    c.autoReleaseSlowCoeff = DSPUtils::calculateCoefficient(currentSampleRate, 800.0f);
+
+    // Makeup is folded into the gain exponent
+    c.makeupLog2 = makeup / DSPUtils::decibelsPerLog2;
 
     // Sidechain HPF coefficient (~150Hz)
-    scHpfCoeff = std::exp(-2.0f * 3.14159265359f * 150.0f / static_cast<float>(currentSampleRate));
+    c.scHpfCoeff = std::exp(-2.0f * 3.14159265359f * 150.0f / static_cast<float>(currentSampleRate));
+
+    c.sidechainHPF = sidechainHPF;
+    c.stereoLink = stereoLink;
+    c.bypassed = bypassed;
+
+    c.controlInterval = controlRate ? chooseControlInterval(c) : 1;
+    c.controlStepLimitLog2 = controlRateErrorBoundDb / DSPUtils::decibelsPerLog2;
+
+    coefficients.publish(c);
 }
 
 void NeveCompressor::setThreshold(float thresholdDb)
 {
     threshold = std::clamp(thresholdDb, -40.0f, 10.0f);
+    updateCoefficients();
 }
 
 void NeveCompressor::setRatio(int index)
 {
     ratioIndex = std::clamp(index, 0, 4);
-    ratio = ratios[ratioIndex];
+    updateCoefficients();
 }
 
 void NeveCompressor::setAttack(int index)
 {
     attackIndex = std::clamp(index, 0, 2);
-    attackMs = attackTimes[attackIndex];
-    attackCoeff = DSPUtils::calculateCoefficient(currentSampleRate, attackMs);
+    updateCoefficients();
 }
 
 void NeveCompressor::setRelease(int index)
 {
     releaseIndex = std::clamp(index, 0, 3);
-    if (releaseIndex < 3)
-    {
-        releaseMs = releaseTimes[releaseIndex];
-        releaseCoeff = DSPUtils::calculateCoefficient(currentSampleRate, releaseMs);
-    }
+    updateCoefficients();
 }
 
 void NeveCompressor::setMakeup(float makeupDb)
 {
     makeup = std::clamp(makeupDb, 0.0f, 20.0f);
-    makeupLinear = DSPUtils::decibelsToLinear(makeup);
+    updateCoefficients();
 }
 
 void NeveCompressor::setSidechainHPF(bool enabled)
 {
     sidechainHPF = enabled;
+    updateCoefficients();
 }
 
 void NeveCompressor::setStereoLink(bool enabled)
 {
     stereoLink = enabled;
+    updateCoefficients();
 }
 
-float NeveCompressor::computeGain(float inputLevel)
+void NeveCompressor::setControlRate(bool enabled)
 {
-    float inputDb = DSPUtils::linearToDecibels(inputLevel);
+    controlRate = enabled;
+    updateCoefficients();
+}
 
-    if (inputDb < threshold)
-        return 1.0f;
+int NeveCompressor::chooseControlInterval(const Coefficients& c)
+{
+    // Fastest the envelope can move (attack is always the faster side,
+    // but take the release into account in case that ever changes)
+    const float coeff = std::max(c.attackCoeff, c.autoRelease ? c.autoReleaseFastCoeff : c.releaseCoeff);
 
-    // Soft knee characteristic (diode bridge style)
-    // Knee width of about 6dB for smooth compression onset
-    float kneeWidth = 6.0f;
-    float overThreshold = inputDb - threshold;
+    // A one-pole segment interpolated linearly over N samples deviates by at
+    // most (coeff * N)^2 / 8 of its remaining swing. Allow the detector to sit
+    // up to 20 dB away from its target, and scale by the GR slope. Larger
+    // swings are caught by the per-interval step check in the gain pass.
+    const float swing = DSPUtils::decibelsToLinear(20.0f) - 1.0f;
 
-    float gainReductionDb;
-    if (overThreshold < kneeWidth)
-    {
-        // Soft knee region - gradual onset
-        float kneeRatio = overThreshold / kneeWidth;
-        float effectiveRatio = 1.0f + (ratio - 1.0f) * kneeRatio * kneeRatio;
-        gainReductionDb = overThreshold * (1.0f - 1.0f / effectiveRatio);
-    }
-    else
+    for (int interval = maxControlInterval; interval >= minControlInterval; interval /= 2)
     {
-        // Above knee - full ratio
-        float softKneeGR = kneeWidth * (1.0f - 1.0f / ratio) * 0.25f;
-        gainReductionDb = softKneeGR + (overThreshold - kneeWidth) * (1.0f - 1.0f / ratio);
-    }
+        const float span = coeff * static_cast<float>(interval);
+        const float deviation = span * span * 0.125f * swing;
+        const float errorDb = c.fullRatioSlope * DSPUtils::linearToDecibels(1.0f + deviation);
 
-    currentGainReduction = gainReductionDb;
+        if (errorDb <= controlRateErrorBoundDb)
+            return interval;
+    }
 
-    return DSPUtils::decibelsToLinear(-gainReductionDb);
+    return 1;
 }
 
-void NeveCompressor::process(juce::AudioBuffer<float>& buffer)
+void NeveCompressor::detectEnvelope(const float* left, const float* right, int numSamples,
+                                    const Coefficients& c)
 {
-    if (bypassed)
-        return;
+    using SIMD::Float2;
 
-    const int numChannels = buffer.getNumChannels();
-    const int numSamples = buffer.getNumSamples();
+    const Float2 attackCoeff = Float2::broadcast(c.attackCoeff);
+    const Float2 hpfCoeff = Float2::broadcast(1.0f - c.scHpfCoeff);
 
-    if (numChannels == 0)
-        return;
+    Float2 hpfState = Float2::fromValues(scHpfStateL, scHpfStateR);
+    Float2 envelope = Float2::fromValues(envelopeL, envelopeR);
 
-    float* left = buffer.getWritePointer(0);
-    float* right = numChannels > 1 ? buffer.getWritePointer(1) : nullptr;
+    // Without control rate the whole chunk is one interval
+    const int interval = c.controlInterval > 1 ? c.controlInterval : chunkSize;
+    int numPoints = 0;
 
-    for (int i = 0; i < numSamples; ++i)
+    for (int start = 0; start < numSamples; start += interval)
     {
-        float inputL = left[i];
-        float inputR = right ? right[i] : inputL;
-
-        // Sidechain signal (optionally high-passed)
-        float scL = inputL;
-        float scR = inputR;
+        const int end = std::min(start + interval, numSamples);
+        Float2 low = envelope;
+        Float2 high = envelope;
 
-        if (sidechainHPF)
+        for (int i = start; i < end; ++i)
         {
-            // Simple high-pass filter on sidechain
-            float hpL = inputL - scHpfStateL;
-            scHpfStateL = scHpfStateL + (1.0f - scHpfCoeff) * hpL;
-            scL = hpL;
+            // Sidechain signal (optionally high-passed)
+            Float2 sidechain = Float2::load(left + i, right + i);
 
-            if (right)
+            if (c.sidechainHPF)
             {
-                float hpR = inputR - scHpfStateR;
-                scHpfStateR = scHpfStateR + (1.0f - scHpfCoeff) * hpR;
-                scR = hpR;
+                // Simple high-pass filter on sidechain
+                Float2 highPassed = sidechain - hpfState;
+                hpfState = hpfState + hpfCoeff * highPassed;
+                sidechain = highPassed;
             }
+
+            // Envelope detection; linked stereo follows the louder channel in both lanes
+            Float2 level = abs(sidechain);
+
+            if (c.stereoLink)
+                level = Float2::broadcast(std::max(level.left(), level.right()));
+
+            // Auto-release calculation
+            float currentReleaseCoeff = c.releaseCoeff;
+            if (c.autoRelease)
+            {
+                // Program-dependent release: faster for transients, slower for sustained
+                // Track program density (linked level, or the left channel when unlinked)
+                float targetAutoEnv = level.left();
+                if (targetAutoEnv > autoReleaseEnv)
+                    autoReleaseEnv += 0.001f * (targetAutoEnv - autoReleaseEnv);
+                else
+                    autoReleaseEnv += 0.0001f * (targetAutoEnv - autoReleaseEnv);
+
+                // Mix fast/slow based on density
+                float density = std::min(1.0f, autoReleaseEnv * 10.0f);
+                currentReleaseCoeff = c.autoReleaseFastCoeff * (1.0f - density) + c.autoReleaseSlowCoeff * density;
+            }
+
+            // Envelope follower with attack/release, per lane
+            const Float2 coeff = select(lessThan(envelope, level), attackCoeff, Float2::broadcast(currentReleaseCoeff));
+            envelope = envelope + coeff * (level - envelope);
+
+            envelope.store(envelopeBuffer[0] + i, envelopeBuffer[1] + i);
+            low = min(low, envelope);
+            high = max(high, envelope);
         }
 
-        // Envelope detection
-        float levelL = std::abs(scL);
-        float levelR = std::abs(scR);
+        envelope.store(pointEnvelope[0] + numPoints, pointEnvelope[1] + numPoints);
+        low.store(lowEnvelope[0] + numPoints, lowEnvelope[1] + numPoints);
+        high.store(highEnvelope[0] + numPoints, highEnvelope[1] + numPoints);
+        ++numPoints;
+    }
 
-        float targetLevel;
-        if (stereoLink && right)
+    scHpfStateL = hpfState.left();
+    scHpfStateR = hpfState.right();
+    envelopeL = envelope.left();
+    envelopeR = envelope.right();
+
+    // Repeat the last envelope into the padding so it can't widen the GR range
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        for (int i = numSamples; (i & 3) != 0; ++i)
+            envelopeBuffer[channel][i] = envelopeBuffer[channel][numSamples - 1];
+
+        for (int k = numPoints; (k & 3) != 0; ++k)
         {
-            // Use max of both channels for stereo link
-            targetLevel = std::max(levelL, levelR);
+            pointEnvelope[channel][k] = pointEnvelope[channel][numPoints - 1];
+            lowEnvelope[channel][k] = lowEnvelope[channel][numPoints - 1];
+            highEnvelope[channel][k] = highEnvelope[channel][numPoints - 1];
         }
-        else
+    }
+}
+
+NeveCompressor::ReductionStats NeveCompressor::computeGains(const float* envelope, float* gains,
+                                                            int numSamples, const Coefficients& c)
+{
+    const GainCurve curve(c);
+    const Float4 zero = curve.zero;
+    const Float4 makeupLog2 = Float4::broadcast(c.makeupLog2);
+
+    const Float4 four = Float4::broadcast(4.0f);
+    const Float4 laneIndex = Float4::fromValues(0.0f, 1.0f, 2.0f, 3.0f);
+
+    Float4 minGainReduction = Float4::broadcast(std::numeric_limits<float>::max());
+    Float4 maxGainReduction = zero;
+    Float4 sumGainReduction = zero;
+    Float4 remaining = Float4::broadcast(static_cast<float>(numSamples));
+
+    // Buffers are padded to a whole number of Float4s
+    for (int i = 0; i < numSamples; i += 4)
+    {
+        const Float4 gainReduction = curve.reduction(curve.overThreshold(Float4::load(envelope + i)));
+        minGainReduction = min(minGainReduction, gainReduction);
+        maxGainReduction = max(maxGainReduction, gainReduction);
+
+        // Padding lanes repeat the last envelope: harmless to the extremes,
+        // masked out of the sum
+        sumGainReduction = sumGainReduction + select(lessThan(laneIndex, remaining), gainReduction, zero);
+        remaining = remaining - four;
+
+        DSPUtils::fastExp2(makeupLog2 - gainReduction).store(gains + i);
+    }
+
+    return { minGainReduction.horizontalMin(), maxGainReduction.horizontalMax(),
+             sumGainReduction.horizontalSum(), numSamples };
+}
+
+void NeveCompressor::findExactIntervals(const float* lowEnvelope, const float* highEnvelope, float* exact,
+                                        int numPoints, const Coefficients& c)
+{
+    // The gain falls monotonically with the envelope on either side of the
+    // knee end, so both a ramp and the exact gains lie between the gains at
+    // the interval's envelope extremes, and the ramp can't be further off
+    // than their difference. Intervals where that exceeds the bound, or whose
+    // extremes straddle the knee end (where the transfer curve steps), are
+    // computed per sample instead.
+    const GainCurve curve(c);
+    const Float4 stepLimit = Float4::broadcast(c.controlStepLimitLog2);
+
+    for (int k = 0; k < numPoints; k += 4)
+    {
+        // The knee test is the one reduction() branches on, so it agrees
+        // with the per-sample pass right at the edge
+        const Float4 low = curve.overThreshold(Float4::load(lowEnvelope + k));
+        const Float4 high = curve.overThreshold(Float4::load(highEnvelope + k));
+        const Float4 spread = curve.reduction(high) - curve.reduction(low);
+        const Float4 lowInKnee = lessThan(low, curve.kneeWidth);
+        const Float4 straddles = select(lessThan(high, curve.kneeWidth), curve.zero, lowInKnee);
+
+        select(lessThan(stepLimit, spread), curve.one, select(straddles, curve.one, curve.zero)).store(exact + k);
+    }
+}
+
+NeveCompressor::ReductionStats NeveCompressor::computeControlRateGains(int channel, int numSamples,
+                                                                       const Coefficients& c)
+{
+    const int interval = c.controlInterval;
+    const int numPoints = (numSamples + interval - 1) / interval;
+    const float* envelope = envelopeBuffer[channel];
+    float* gains = gainBuffer[channel];
+
+    alignas(16) float pointGains[maxControlPoints];
+    alignas(16) float exact[maxControlPoints];
+
+    // The mean is taken over the control points
+    ReductionStats stats = computeGains(pointEnvelope[channel], pointGains, numPoints, c);
+    findExactIntervals(lowEnvelope[channel], highEnvelope[channel], exact, numPoints, c);
+
+    // Linear ramps from the previous point (after a reset the envelope is
+    // silent, i.e. makeup gain only)
+    float previous = lastGainValid ? lastGain[channel] : DSPUtils::fastExp2(c.makeupLog2);
+
+    for (int k = 0; k < numPoints; ++k)
+    {
+        const int start = k * interval;
+        const int span = std::min(interval, numSamples - start);
+
+        if (exact[k] != 0.0f)
         {
-            targetLevel = levelL;  // For mono or unlinked left
+            // Interval starts are multiples of 4, so the padded pass stays inside the chunk
+            const ReductionStats exactStats = computeGains(envelope + start, gains + start, span, c);
+            stats.least = std::min(stats.least, exactStats.least);
+            stats.most = std::max(stats.most, exactStats.most);
         }
-
-        // Auto-release calculation
-        float currentReleaseCoeff = releaseCoeff;
-        if (releaseIndex == 3)  // Auto release
+        else
         {
-            // Program-dependent release: faster for transients, slower for sustained
-            float autoReleaseFast = DSPUtils::calculateCoefficient(currentSampleRate, 50.0f);
-            float autoReleaseSlow = DSPUtils::calculateCoefficient(currentSampleRate, 800.0f);
-
-            // Track program density
-            float targetAutoEnv = targetLevel;
-            if (targetAutoEnv > autoReleaseEnv)
-                autoReleaseEnv += 0.001f * (targetAutoEnv - autoReleaseEnv);
-            else
-                autoReleaseEnv += 0.0001f * (targetAutoEnv - autoReleaseEnv);
-
-            // Mix fast/slow based on density
-            float density = std::min(1.0f, autoReleaseEnv * 10.0f);
-            currentReleaseCoeff = autoReleaseFast * (1.0f - density) + autoReleaseSlow * density;
+            const float step = (pointGains[k] - previous) / static_cast<float>(span);
+
+            for (int j = 0; j < span; ++j)
+                gains[start + j] = previous + step * static_cast<float>(j + 1);
         }
 
-        // Envelope follower with attack/release
-        if (targetLevel > envelopeL)
-            envelopeL += attackCoeff * (targetLevel - envelopeL);
-        else
-            envelopeL += currentReleaseCoeff * (targetLevel - envelopeL);
+        previous = pointGains[k];
+    }
 
-        // Compute gain
-        float gain = computeGain(envelopeL);
+    return stats;
+}
 
-        // Apply gain with makeup
-        left[i] = inputL * gain * makeupLinear;
+// Pass 3: samples *= gains
+static void applyGains(float* samples, const float* gains, int numSamples)
+{
+    using SIMD::Float4;
 
-        if (right)
-        {
-            if (stereoLink)
-            {
-                // Same gain for both channels
-                right[i] = inputR * gain * makeupLinear;
-            }
-            else
-            {
-                // Independent envelope for right channel
-                if (levelR > envelopeR)
-                    envelopeR += attackCoeff * (levelR - envelopeR);
-                else
-                    envelopeR += currentReleaseCoeff * (levelR - envelopeR);
+    int i = 0;
+    for (; i + 4 <= numSamples; i += 4)
+        (Float4::load(samples + i) * Float4::load(gains + i)).store(samples + i);
 
-                float gainR = computeGain(envelopeR);
-                right[i] = inputR * gainR * makeupLinear;
-            }
+    for (; i < numSamples; ++i)
+        samples[i] *= gains[i];
+}
+
+void NeveCompressor::process(AudioSpan buffer)
+{
+    coefficients.pull();
+    const Coefficients& c = coefficients.current();
+
+    if (c.bypassed)
+    {
+        gainReductionStats.store({});
+        return;
+    }
+
+    const int numChannels = buffer.getNumChannels();
+    const int numSamples = buffer.getNumSamples();
+
+    if (numChannels == 0)
+        return;
+
+    float* left = buffer.getWritePointer(0);
+    float* right = numChannels > 1 ? buffer.getWritePointer(1) : nullptr;
+
+    // Only unlinked stereo needs a second gain curve
+    const bool independentRight = right != nullptr && ! c.stereoLink;
+
+    ReductionStats stats;
+
+    for (int start = 0; start < numSamples; start += chunkSize)
+    {
+        const int n = std::min(chunkSize, numSamples - start);
+
+        // Mono runs with right aliased to left: both lanes carry the same envelope
+        detectEnvelope(left + start, (right != nullptr ? right : left) + start, n, c);
+
+        for (int channel = 0; channel < (independentRight ? 2 : 1); ++channel)
+        {
+            stats.include(c.controlInterval > 1
+                              ? computeControlRateGains(channel, n, c)
+                              : computeGains(envelopeBuffer[channel], gainBuffer[channel], n, c));
         }
+
+        applyGains(left + start, gainBuffer[0], n);
+        if (right != nullptr)
+            applyGains(right + start, gainBuffer[independentRight ? 1 : 0], n);
+
+        // Control-rate ramps continue from here (also across mode/link switches)
+        lastGain[0] = gainBuffer[0][n - 1];
+        lastGain[1] = gainBuffer[independentRight ? 1 : 0][n - 1];
+        lastGainValid = true;
     }
+
+    // Metering: this block's statistics, published as one word
+    if (stats.count > 0)
+        gainReductionStats.store({ stats.least * DSPUtils::decibelsPerLog2,
+                                   stats.most * DSPUtils::decibelsPerLog2,
+                                   stats.sum / static_cast<float>(stats.count) * DSPUtils::decibelsPerLog2 });
 }
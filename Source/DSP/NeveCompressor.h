@@ -1,6 +1,10 @@
 #pragma once
 
-#include <JuceHeader.h>
+#include "AudioSpan.h"
+#include "SnapshotExchange.h"
+#include "GainReductionStats.h"
+#include <algorithm>
+#include <limits>
 
 /**
  * Neve-style Compressor (2254/33609 inspired)
@@ -12,6 +16,15 @@
  * - Diode bridge detection (soft knee characteristic)
  * - Sidechain high-pass filter
  * - Stereo linking option
+ * - Gain computer runs in the log2 domain (fast log2/exp2)
+ * - Block-wise pipeline: sidechain/envelope pass (stereo as two SIMD
+ *   lanes), then a 4-wide gain-curve pass, then a 4-wide gain apply
+ * - Optional control-rate gain: the gain computer runs every N samples
+ *   and is linearly interpolated, N picked from attack/release so the
+ *   estimated error stays under controlRateErrorBoundDb
+ *
+ * Threading: setters run on one non-realtime thread and publish a
+ * Coefficients snapshot; process() adopts the newest one per block.
  */
 class NeveCompressor
 {
@@ -28,7 +41,7 @@ public:
     NeveCompressor();
 
     void prepare(double sampleRate, int samplesPerBlock);
-    void process(juce::AudioBuffer<float>& buffer);
+    void process(AudioSpan buffer);
     void reset();
 
     // Parameters
@@ -39,17 +52,85 @@ public:
     void setMakeup(float makeupDb);          // 0 to +20 dB
     void setSidechainHPF(bool enabled);      // Enable/disable sidechain HPF
     void setStereoLink(bool enabled);        // Stereo linking
+    void setControlRate(bool enabled);       // Gain computer at control rate
 
     // Bypass
-    void setBypass(bool shouldBypass) { bypassed = shouldBypass; }
+    void setBypass(bool shouldBypass) { bypassed = shouldBypass; updateCoefficients(); }
     bool isBypassed() const { return bypassed; }
 
-    // Metering
-    float getGainReduction() const { return currentGainReduction; }
+    // Metering, any thread: the last block's GR statistics (dB), and its deepest GR
+    GainReductionStats getGainReductionStats() const { return gainReductionStats.load(); }
+    float getGainReduction() const { return gainReductionStats.load().maximum; }
+
+    // Everything process() reads, derived off the audio thread
+    struct Coefficients
+    {
+        // Gain computer, in log2 units (1 unit = 6.02 dB)
+        float thresholdLog2 = -20.0f / 6.02059991f;
+        float ratioMinusOne = 2.0f;
+        float fullRatioSlope = 1.0f - 1.0f / 3.0f;   // GR per unit above the knee
+        float kneeEndGR = 0.0f;                      // GR where the full-ratio segment starts
+        float makeupLog2 = 0.0f;
+        int controlInterval = 1;                     // Samples per gain computation
+        float controlStepLimitLog2 = 0.0f;           // Largest GR change one ramp may cover
+
+        float attackCoeff = 0.0f;
+        float releaseCoeff = 0.0f;
+        float autoReleaseFastCoeff = 0.0f;
+        float autoReleaseSlowCoeff = 0.0f;
+        float scHpfCoeff = 0.0f;
+        bool autoRelease = false;
+        bool sidechainHPF = false;
+        bool stereoLink = true;
+        bool bypassed = false;
+    };
 
 private:
     void updateCoefficients();
-    float computeGain(float inputLevel);
+
+    // Gain reduction statistics over one or more passes (log2 units)
+    struct ReductionStats
+    {
+        float least = std::numeric_limits<float>::max();
+        float most = 0.0f;
+        float sum = 0.0f;
+        int count = 0;
+
+        void include(const ReductionStats& other)
+        {
+            least = std::min(least, other.least);
+            most = std::max(most, other.most);
+            sum += other.sum;
+            count += other.count;
+        }
+    };
+
+    // Pass 1: sidechain HPF + envelope follower into envelopeBuffer (L/R lanes),
+    // plus each control interval's end point and extremes
+    void detectEnvelope(const float* left, const float* right, int numSamples, const Coefficients& c);
+
+    // Pass 2: envelope -> linear gain with makeup; returns the GR statistics
+    static ReductionStats computeGains(const float* envelope, float* gains, int numSamples, const Coefficients& c);
+
+    // Pass 2 at control rate: gain at the end of every interval, interpolated in between
+    ReductionStats computeControlRateGains(int channel, int numSamples, const Coefficients& c);
+
+    // Flags (1.0f) the control intervals a ramp can't cover within the bound
+    static void findExactIntervals(const float* lowEnvelope, const float* highEnvelope, float* exact,
+                                   int numPoints, const Coefficients& c);
+
+    // Longest interval whose estimated interpolation error stays in bounds
+    static int chooseControlInterval(const Coefficients& c);
+
+    // Samples per pipeline pass; longer blocks are split
+    static constexpr int chunkSize = 256;
+
+    // Control-rate limits (powers of two; chunkSize must be a multiple of the
+    // interval, and interval starts must stay Float4-aligned)
+    static constexpr int minControlInterval = 4;
+    static constexpr int maxControlInterval = 64;
+    static constexpr float controlRateErrorBoundDb = 0.1f;
+    static constexpr int maxControlPoints = chunkSize / minControlInterval + 4;
 
     double currentSampleRate = 44100.0;
     bool bypassed = false;
@@ -62,25 +143,34 @@ private:
     float makeup = 0.0f;
     bool sidechainHPF = false;
     bool stereoLink = true;
+    bool controlRate = false;
 
-    // Derived values
-    float ratio = 3.0f;
-    float attackMs = 8.0f;
-    float releaseMs = 400.0f;
-    float attackCoeff = 0.0f;
-    float releaseCoeff = 0.0f;
-    float makeupLinear = 1.0f;
+    // Published to the audio thread
+    SnapshotExchange<Coefficients> coefficients;
 
     // State
     float envelopeL = 0.0f;
     float envelopeR = 0.0f;
-    float currentGainReduction = 0.0f;
+    AtomicGainReductionStats gainReductionStats;
     float autoReleaseEnv = 0.0f;
 
     // Sidechain HPF state (high-pass at ~150Hz)
     float scHpfStateL = 0.0f;
     float scHpfStateR = 0.0f;
-    float scHpfCoeff = 0.0f;
+
+    // Per-chunk working buffers (left/right), padded to whole Float4s
+    alignas(16) float envelopeBuffer[2][chunkSize] {};
+    alignas(16) float gainBuffer[2][chunkSize] {};
+
+    // Per control interval: envelope at its end, and its extremes over the
+    // interval including the previous end point (padded like the above)
+    alignas(16) float pointEnvelope[2][maxControlPoints] {};
+    alignas(16) float lowEnvelope[2][maxControlPoints] {};
+    alignas(16) float highEnvelope[2][maxControlPoints] {};
+
+    // Gain at the end of the previous chunk, per channel (control-rate start point)
+    float lastGain[2] { 1.0f, 1.0f };
+    bool lastGainValid = false;
 
     // Lookup tables
     static constexpr float ratios[5] = { 1.5f, 2.0f, 3.0f, 4.0f, 6.0f };
@@ -1,5 +1,6 @@
 #include "NeveEQ.h"
 #include "DSPUtils.h"
+#include "SharedTableCache.h"
 
 constexpr float NeveEQ::hfFreqs[3];
 constexpr float NeveEQ::hmFreqs[5];
@@ -13,6 +14,7 @@ NeveEQ::NeveEQ()
 void NeveEQ::prepare(double sampleRate, int /*samplesPerBlock*/)
 {
     currentSampleRate = sampleRate;
+    coefficientTable = SharedTableCache<CoefficientTable>::get(sampleRate, buildCoefficientTable);
     updateHFCoefficients();
     updateHMCoefficients();
     updateLMCoefficients();
@@ -22,14 +24,10 @@ void NeveEQ::prepare(double sampleRate, int /*samplesPerBlock*/)
 
 void NeveEQ::reset()
 {
-    hfX1L = hfX2L = hfY1L = hfY2L = 0.0f;
-    hfX1R = hfX2R = hfY1R = hfY2R = 0.0f;
-    hmX1L = hmX2L = hmY1L = hmY2L = 0.0f;
-    hmX1R = hmX2R = hmY1R = hmY2R = 0.0f;
-    lmX1L = lmX2L = lmY1L = lmY2L = 0.0f;
-    lmX1R = lmX2R = lmY1R = lmY2R = 0.0f;
-    lfX1L = lfX2L = lfY1L = lfY2L = 0.0f;
-    lfX1R = lfX2R = lfY1R = lfY2R = 0.0f;
+    hfFilter.reset();
+    hmFilter.reset();
+    lmFilter.reset();
+    lfFilter.reset();
 }
 
 float NeveEQ::calculateProportionalQ(float gainDb, float baseQ)
@@ -45,6 +43,85 @@ float NeveEQ::calculateProportionalQ(float gainDb, float baseQ)
     return baseQ * qMultiplier;
 }
 
+int NeveEQ::quantiseGain(float gainDb, float maxGainDb, float& steppedGainDb)
+{
+    int index = static_cast<int>(std::lround((std::clamp(gainDb, -maxGainDb, maxGainDb) + maxGainDb) * 10.0f));
+    int centre = static_cast<int>(std::lround(maxGainDb * 10.0f));
+    steppedGainDb = static_cast<float>(index - centre) * 0.1f;
+    return index;
+}
+
+void NeveEQ::buildCoefficientTable(CoefficientTable& table, double sampleRate)
+{
+    // Bands below 0.1 dB keep the default pass-through coefficients
+    auto stepGain = [](int index, float maxGainDb)
+    {
+        return static_cast<float>(index - static_cast<int>(std::lround(maxGainDb * 10.0f))) * 0.1f;
+    };
+
+    for (int f = 0; f < 3; ++f)
+    {
+        for (int g = 0; g < CoefficientTable::shelfGainSteps; ++g)
+        {
+            float gain = stepGain(g, 16.0f);
+            if (std::abs(gain) < 0.1f)
+                continue;
+
+            // Neve shelves have a gentle slope with smooth Q
+            float q = 0.6f;
+
+            auto& c = table.hf[f][g];
+            DSPUtils::calculateHighShelf(hfFreqs[f], gain, q, sampleRate, c.b0, c.b1, c.b2, c.a1, c.a2);
+        }
+    }
+
+    for (int f = 0; f < 5; ++f)
+    {
+        for (int g = 0; g < CoefficientTable::bellGainSteps; ++g)
+        {
+            float gain = stepGain(g, 12.0f);
+            if (std::abs(gain) < 0.1f)
+                continue;
+
+            float q = calculateProportionalQ(gain, 1.0f);
+
+            auto& c = table.hm[f][g];
+            DSPUtils::calculatePeakingEQ(hmFreqs[f], gain, q, sampleRate, c.b0, c.b1, c.b2, c.a1, c.a2);
+        }
+    }
+
+    for (int f = 0; f < 5; ++f)
+    {
+        for (int g = 0; g < CoefficientTable::shelfGainSteps; ++g)
+        {
+            float gain = stepGain(g, 16.0f);
+            if (std::abs(gain) < 0.1f)
+                continue;
+
+            float q = calculateProportionalQ(gain, 0.8f);
+
+            auto& c = table.lm[f][g];
+            DSPUtils::calculatePeakingEQ(lmFreqs[f], gain, q, sampleRate, c.b0, c.b1, c.b2, c.a1, c.a2);
+        }
+    }
+
+    for (int f = 0; f < 4; ++f)
+    {
+        for (int g = 0; g < CoefficientTable::shelfGainSteps; ++g)
+        {
+            float gain = stepGain(g, 16.0f);
+            if (std::abs(gain) < 0.1f)
+                continue;
+
+            // Neve low shelves have a characteristic gentle slope
+            float q = 0.5f;
+
+            auto& c = table.lf[f][g];
+            DSPUtils::calculateLowShelf(lfFreqs[f], gain, q, sampleRate, c.b0, c.b1, c.b2, c.a1, c.a2);
+        }
+    }
+}
+
 // HF Section (High Shelf)
 void NeveEQ::setHFFreq(int index)
 {
@@ -54,24 +131,14 @@ void NeveEQ::setHFFreq(int index)
 
 void NeveEQ::setHFGain(float gainDb)
 {
-    hfGain = std::clamp(gainDb, -16.0f, 16.0f);
+    hfGainIndex = quantiseGain(gainDb, 16.0f, hfGain);
     updateHFCoefficients();
 }
 
 void NeveEQ::updateHFCoefficients()
 {
-    if (std::abs(hfGain) < 0.1f)
-    {
-        hfB0 = 1.0f; hfB1 = 0.0f; hfB2 = 0.0f; hfA1 = 0.0f; hfA2 = 0.0f;
-        return;
-    }
-
-    float freq = hfFreqs[hfFreqIndex];
-    // Neve shelves have a gentle slope with smooth Q
-    float q = 0.6f;
-
-    DSPUtils::calculateHighShelf(freq, hfGain, q, currentSampleRate,
-                                  hfB0, hfB1, hfB2, hfA1, hfA2);
+    if (coefficientTable != nullptr)
+        hfFilter.setCoefficients(coefficientTable->hf[hfFreqIndex][hfGainIndex]);
 }
 
 // HM Section (Parametric Bell)
@@ -83,23 +150,14 @@ void NeveEQ::setHMFreq(int index)
 
 void NeveEQ::setHMGain(float gainDb)
 {
-    hmGain = std::clamp(gainDb, -12.0f, 12.0f);
+    hmGainIndex = quantiseGain(gainDb, 12.0f, hmGain);
     updateHMCoefficients();
 }
 
 void NeveEQ::updateHMCoefficients()
 {
-    if (std::abs(hmGain) < 0.1f)
-    {
-        hmB0 = 1.0f; hmB1 = 0.0f; hmB2 = 0.0f; hmA1 = 0.0f; hmA2 = 0.0f;
-        return;
-    }
-
-    float freq = hmFreqs[hmFreqIndex];
-    float q = calculateProportionalQ(hmGain, 1.0f);
-
-    DSPUtils::calculatePeakingEQ(freq, hmGain, q, currentSampleRate,
-                                  hmB0, hmB1, hmB2, hmA1, hmA2);
+    if (coefficientTable != nullptr)
+        hmFilter.setCoefficients(coefficientTable->hm[hmFreqIndex][hmGainIndex]);
 }
 
 // LM Section (Parametric Bell)
@@ -111,23 +169,14 @@ void NeveEQ::setLMFreq(int index)
 
 void NeveEQ::setLMGain(float gainDb)
 {
-    lmGain = std::clamp(gainDb, -16.0f, 16.0f);
+    lmGainIndex = quantiseGain(gainDb, 16.0f, lmGain);
     updateLMCoefficients();
 }
 
 void NeveEQ::updateLMCoefficients()
 {
-    if (std::abs(lmGain) < 0.1f)
-    {
-        lmB0 = 1.0f; lmB1 = 0.0f; lmB2 = 0.0f; lmA1 = 0.0f; lmA2 = 0.0f;
-        return;
-    }
-
-    float freq = lmFreqs[lmFreqIndex];
-    float q = calculateProportionalQ(lmGain, 0.8f);
-
-    DSPUtils::calculatePeakingEQ(freq, lmGain, q, currentSampleRate,
-                                  lmB0, lmB1, lmB2, lmA1, lmA2);
+    if (coefficientTable != nullptr)
+        lmFilter.setCoefficients(coefficientTable->lm[lmFreqIndex][lmGainIndex]);
 }
 
 // LF Section (Low Shelf)
@@ -139,27 +188,43 @@ void NeveEQ::setLFFreq(int index)
 
 void NeveEQ::setLFGain(float gainDb)
 {
-    lfGain = std::clamp(gainDb, -16.0f, 16.0f);
+    lfGainIndex = quantiseGain(gainDb, 16.0f, lfGain);
     updateLFCoefficients();
 }
 
 void NeveEQ::updateLFCoefficients()
 {
-    if (std::abs(lfGain) < 0.1f)
+    if (coefficientTable != nullptr)
+        lfFilter.setCoefficients(coefficientTable->lf[lfFreqIndex][lfGainIndex]);
+}
+
+int NeveEQ::getActiveBands() const
+{
+    int bands = 0;
+    if (std::abs(lfGain) >= 0.1f) bands |= BAND_LF;
+    if (std::abs(lmGain) >= 0.1f) bands |= BAND_LM;
+    if (std::abs(hmGain) >= 0.1f) bands |= BAND_HM;
+    if (std::abs(hfGain) >= 0.1f) bands |= BAND_HF;
+    return bands;
+}
+
+template <int ActiveBands>
+void NeveEQ::processCascade(float* left, float* right, int numSamples)
+{
+    for (int i = 0; i < numSamples; ++i)
     {
-        lfB0 = 1.0f; lfB1 = 0.0f; lfB2 = 0.0f; lfA1 = 0.0f; lfA2 = 0.0f;
-        return;
-    }
+        SIMD::Float2 sample = SIMD::Float2::load(left + i, right + i);
 
-    float freq = lfFreqs[lfFreqIndex];
-    // Neve low shelves have a characteristic gentle slope
-    float q = 0.5f;
+        if constexpr ((ActiveBands & BAND_LF) != 0) sample = lfFilter.processSample(sample);  // LF Shelf
+        if constexpr ((ActiveBands & BAND_LM) != 0) sample = lmFilter.processSample(sample);  // LM Bell
+        if constexpr ((ActiveBands & BAND_HM) != 0) sample = hmFilter.processSample(sample);  // HM Bell
+        if constexpr ((ActiveBands & BAND_HF) != 0) sample = hfFilter.processSample(sample);  // HF Shelf
 
-    DSPUtils::calculateLowShelf(freq, lfGain, q, currentSampleRate,
-                                 lfB0, lfB1, lfB2, lfA1, lfA2);
+        sample.store(left + i, right + i);
+    }
 }
 
-void NeveEQ::process(juce::AudioBuffer<float>& buffer)
+void NeveEQ::process(AudioSpan buffer)
 {
     if (bypassed)
         return;
@@ -170,105 +235,29 @@ void NeveEQ::process(juce::AudioBuffer<float>& buffer)
     if (numChannels == 0)
         return;
 
-    // Check if all bands are at unity (no processing needed)
-    bool needsProcessing = (std::abs(hfGain) >= 0.1f ||
-                            std::abs(hmGain) >= 0.1f ||
-                            std::abs(lmGain) >= 0.1f ||
-                            std::abs(lfGain) >= 0.1f);
+    // Resolve the active band set once per block
+    const int activeBands = getActiveBands();
 
-    if (!needsProcessing)
+    // All bands at unity - no processing needed
+    if (activeBands == 0)
         return;
 
-    // Process left channel
+    // Mono runs with right aliased to left: both lanes see the same input,
+    // so the right lane (stored last) carries the same result
     float* left = buffer.getWritePointer(0);
-    for (int i = 0; i < numSamples; ++i)
-    {
-        float sample = left[i];
-
-        // LF Shelf
-        if (std::abs(lfGain) >= 0.1f)
-        {
-            float y = lfB0 * sample + lfB1 * lfX1L + lfB2 * lfX2L - lfA1 * lfY1L - lfA2 * lfY2L;
-            lfX2L = lfX1L; lfX1L = sample;
-            lfY2L = lfY1L; lfY1L = y;
-            sample = y;
-        }
-
-        // LM Bell
-        if (std::abs(lmGain) >= 0.1f)
-        {
-            float y = lmB0 * sample + lmB1 * lmX1L + lmB2 * lmX2L - lmA1 * lmY1L - lmA2 * lmY2L;
-            lmX2L = lmX1L; lmX1L = sample;
-            lmY2L = lmY1L; lmY1L = y;
-            sample = y;
-        }
-
-        // HM Bell
-        if (std::abs(hmGain) >= 0.1f)
-        {
-            float y = hmB0 * sample + hmB1 * hmX1L + hmB2 * hmX2L - hmA1 * hmY1L - hmA2 * hmY2L;
-            hmX2L = hmX1L; hmX1L = sample;
-            hmY2L = hmY1L; hmY1L = y;
-            sample = y;
-        }
-
-        // HF Shelf
-        if (std::abs(hfGain) >= 0.1f)
-        {
-            float y = hfB0 * sample + hfB1 * hfX1L + hfB2 * hfX2L - hfA1 * hfY1L - hfA2 * hfY2L;
-            hfX2L = hfX1L; hfX1L = sample;
-            hfY2L = hfY1L; hfY1L = y;
-            sample = y;
-        }
-
-        left[i] = sample;
-    }
-
-    // Process right channel if stereo
-    if (numChannels > 1)
-    {
-        float* right = buffer.getWritePointer(1);
-        for (int i = 0; i < numSamples; ++i)
-        {
-            float sample = right[i];
-
-            // LF Shelf
-            if (std::abs(lfGain) >= 0.1f)
-            {
-                float y = lfB0 * sample + lfB1 * lfX1R + lfB2 * lfX2R - lfA1 * lfY1R - lfA2 * lfY2R;
-                lfX2R = lfX1R; lfX1R = sample;
-                lfY2R = lfY1R; lfY1R = y;
-                sample = y;
-            }
-
-            // LM Bell
-            if (std::abs(lmGain) >= 0.1f)
-            {
-                float y = lmB0 * sample + lmB1 * lmX1R + lmB2 * lmX2R - lmA1 * lmY1R - lmA2 * lmY2R;
-                lmX2R = lmX1R; lmX1R = sample;
-                lmY2R = lmY1R; lmY1R = y;
-                sample = y;
-            }
-
-            // HM Bell
-            if (std::abs(hmGain) >= 0.1f)
-            {
-                float y = hmB0 * sample + hmB1 * hmX1R + hmB2 * hmX2R - hmA1 * hmY1R - hmA2 * hmY2R;
-                hmX2R = hmX1R; hmX1R = sample;
-                hmY2R = hmY1R; hmY1R = y;
-                sample = y;
-            }
-
-            // HF Shelf
-            if (std::abs(hfGain) >= 0.1f)
-            {
-                float y = hfB0 * sample + hfB1 * hfX1R + hfB2 * hfX2R - hfA1 * hfY1R - hfA2 * hfY2R;
-                hfX2R = hfX1R; hfX1R = sample;
-                hfY2R = hfY1R; hfY1R = y;
-                sample = y;
-            }
-
-            right[i] = sample;
-        }
-    }
+    float* right = numChannels > 1 ? buffer.getWritePointer(1) : left;
+
+    using CascadeFn = void (NeveEQ::*)(float*, float*, int);
+    static constexpr CascadeFn cascades[16] = {
+        &NeveEQ::processCascade<0>,  &NeveEQ::processCascade<1>,
+        &NeveEQ::processCascade<2>,  &NeveEQ::processCascade<3>,
+        &NeveEQ::processCascade<4>,  &NeveEQ::processCascade<5>,
+        &NeveEQ::processCascade<6>,  &NeveEQ::processCascade<7>,
+        &NeveEQ::processCascade<8>,  &NeveEQ::processCascade<9>,
+        &NeveEQ::processCascade<10>, &NeveEQ::processCascade<11>,
+        &NeveEQ::processCascade<12>, &NeveEQ::processCascade<13>,
+        &NeveEQ::processCascade<14>, &NeveEQ::processCascade<15>
+    };
+
+    (this->*cascades[activeBands])(left, right, numSamples);
 }
@@ -1,6 +1,8 @@
 #pragma once
 
-#include <JuceHeader.h>
+#include "AudioSpan.h"
+#include "StereoBiquad.h"
+#include <memory>
 
 /**
  * Neve-style 4-band EQ (1073/1084 inspired)
@@ -14,6 +16,10 @@
  * - Proportional Q (Q narrows with boost - Neve characteristic)
  * - Musical, inductor-like curves
  * - Smooth, never harsh
+ * - Each band is a StereoBiquad (L/R processed together in SIMD lanes)
+ * - Active bands resolved once per block into a branch-free cascade
+ * - Gains are stepped in 0.1 dB; every coefficient set is precomputed
+ *   per sample rate in prepare() and shared across instances
  */
 class NeveEQ
 {
@@ -33,7 +39,7 @@ public:
     NeveEQ();
 
     void prepare(double sampleRate, int samplesPerBlock);
-    void process(juce::AudioBuffer<float>& buffer);
+    void process(AudioSpan buffer);
     void reset();
 
     // HF Section
@@ -56,45 +62,68 @@ public:
     void setBypass(bool shouldBypass) { bypassed = shouldBypass; }
     bool isBypassed() const { return bypassed; }
 
+    // Every stepped coefficient set for one sample rate (~5k biquads)
+    struct CoefficientTable
+    {
+        static constexpr int shelfGainSteps = 321;   // -16 to +16 dB in 0.1 dB steps
+        static constexpr int bellGainSteps = 241;    // -12 to +12 dB in 0.1 dB steps (HM)
+
+        BiquadCoefficients hf[3][shelfGainSteps];
+        BiquadCoefficients hm[5][bellGainSteps];
+        BiquadCoefficients lm[5][shelfGainSteps];
+        BiquadCoefficients lf[4][shelfGainSteps];
+    };
+
 private:
+    static void buildCoefficientTable(CoefficientTable& table, double sampleRate);
+
+    // Snap a gain to its 0.1 dB step: returns the table index, writes the stepped gain
+    static int quantiseGain(float gainDb, float maxGainDb, float& steppedGainDb);
+
     void updateHFCoefficients();
     void updateHMCoefficients();
     void updateLMCoefficients();
     void updateLFCoefficients();
 
     // Calculate proportional Q based on gain
-    float calculateProportionalQ(float gainDb, float baseQ);
+    static float calculateProportionalQ(float gainDb, float baseQ);
+
+    // Active band bits for the cascade dispatch
+    enum BandMask { BAND_LF = 1, BAND_LM = 2, BAND_HM = 4, BAND_HF = 8 };
+    int getActiveBands() const;
+
+    // Fused cascade over only the bands set in ActiveBands (16 instantiations)
+    template <int ActiveBands>
+    void processCascade(float* left, float* right, int numSamples);
 
     double currentSampleRate = 44100.0;
     bool bypassed = false;
 
+    std::shared_ptr<const CoefficientTable> coefficientTable;
+
     // HF parameters and state
     int hfFreqIndex = 0;
     float hfGain = 0.0f;
-    float hfB0 = 1.0f, hfB1 = 0.0f, hfB2 = 0.0f, hfA1 = 0.0f, hfA2 = 0.0f;
-    float hfX1L = 0.0f, hfX2L = 0.0f, hfY1L = 0.0f, hfY2L = 0.0f;
-    float hfX1R = 0.0f, hfX2R = 0.0f, hfY1R = 0.0f, hfY2R = 0.0f;
+    int hfGainIndex = 160;   // 0 dB
+    StereoBiquad hfFilter;
 
     // HM parameters and state
     int hmFreqIndex = 0;
     float hmGain = 0.0f;
-    float hmB0 = 1.0f, hmB1 = 0.0f, hmB2 = 0.0f, hmA1 = 0.0f, hmA2 = 0.0f;
-    float hmX1L = 0.0f, hmX2L = 0.0f, hmY1L = 0.0f, hmY2L = 0.0f;
-    float hmX1R = 0.0f, hmX2R = 0.0f, hmY1R = 0.0f, hmY2R = 0.0f;
+    int hmGainIndex = 120;   // 0 dB
+    StereoBiquad hmFilter;
 
     // LM parameters and state
     int lmFreqIndex = 0;
     float lmGain = 0.0f;
-    float lmB0 = 1.0f, lmB1 = 0.0f, lmB2 = 0.0f, lmA1 = 0.0f, lmA2 = 0.0f;
-    float lmX1L = 0.0f, lmX2L = 0.0f, lmY1L = 0.0f, lmY2L = 0.0f;
-    float lmX1R = 0.0f, lmX2R = 0.0f, lmY1R = 0.0f, lmY2R = 0.0f;
+    int lmGainIndex = 160;   // 0 dB
+    StereoBiquad lmFilter;
 
     // LF parameters and state
     int lfFreqIndex = 0;
     float lfGain = 0.0f;
-    float lfB0 = 1.0f, lfB1 = 0.0f, lfB2 = 0.0f, lfA1 = 0.0f, lfA2 = 0.0f;
-    float lfX1L = 0.0f, lfX2L = 0.0f, lfY1L = 0.0f, lfY2L = 0.0f;
-    float lfX1R = 0.0f, lfX2R = 0.0f, lfY1R = 0.0f, lfY2R = 0.0f;
+    int lfGainIndex = 160;   // 0 dB
+    StereoBiquad lfFilter;
 
     // Frequency lookup tables
     static constexpr float hfFreqs[3] = { 10000.0f, 12000.0f, 16000.0f };
@@ -9,31 +9,137 @@ void NeveLimiter::prepare(double sampleRate, int /*samplesPerBlock*/)
 {
     currentSampleRate = sampleRate;
 
-    // Very fast attack (0.1ms) for limiting
-    attackCoeff = DSPUtils::calculateCoefficient(currentSampleRate, 0.1f);
-    // Moderate release (50ms)
-    releaseCoeff = DSPUtils::calculateCoefficient(currentSampleRate, 50.0f);
+    // Lookahead buffers for this rate, whether or not the mode is on
+    auto nextPowerOfTwo = [](int n) { int p = 1; while (p < n) p <<= 1; return p; };
+
+    const int lookaheadSamples = calculateLookaheadSamples(sampleRate);
+    const int delayLength = nextPowerOfTwo(lookaheadSamples + TruePeakDetector::latencySamples);
+    const int windowLength = nextPowerOfTwo(lookaheadSamples + 1);
+
+    for (auto& channel : delayLine)
+        channel.assign(static_cast<size_t>(delayLength), 0.0f);
+    delayMask = delayLength - 1;
+
+    peakWindow.assign(static_cast<size_t>(windowLength), PeakEntry { 0, 0.0f });
+    windowMask = static_cast<uint32_t>(windowLength - 1);
 
+    rampHistory.assign(static_cast<size_t>(lookaheadSamples), 1.0f);
+
+    updateCoefficients();
     reset();
 }
 
+int NeveLimiter::calculateLookaheadSamples(double sampleRate)
+{
+    return std::max(8, static_cast<int>(std::lround(lookaheadMs * 0.001 * sampleRate)));
+}
+
+int NeveLimiter::getLatencySamples() const
+{
+    if (!lookahead)
+        return 0;
+
+    // Ramp length plus the true-peak interpolator, less the sample the
+    // window and the ramp share
+    return calculateLookaheadSamples(currentSampleRate) + TruePeakDetector::latencySamples - 1;
+}
+
 void NeveLimiter::reset()
 {
-    envelopeL = 0.0f;
-    envelopeR = 0.0f;
-    currentGainReduction = 0.0f;
+    envelope = 0.0f;
+    gainReductionStats.store({});
+    oversampler.reset();
+
+    truePeak[0].reset();
+    truePeak[1].reset();
+    activeLookahead = 0;
+}
+
+void NeveLimiter::resetLookahead(int lookaheadSamples)
+{
+    for (auto& channel : delayLine)
+        std::fill(channel.begin(), channel.end(), 0.0f);
+    delayWrite = 0;
+
+    activeLookahead = lookaheadSamples;
+    resetLookaheadDetector();
+}
+
+void NeveLimiter::resetLookaheadDetector()
+{
+    windowFront = windowBack = 0;
+    sampleTime = 0;
+
+    std::fill(rampHistory.begin(), rampHistory.end(), 1.0f);
+    rampSum = static_cast<double>(activeLookahead);
+    rampPosition = 0;
+    releaseEnvelope = 1.0f;
+
+    truePeak[0].reset();
+    truePeak[1].reset();
+}
+
+void NeveLimiter::updateCoefficients()
+{
+    Coefficients c;
+
+    c.thresholdLinear = DSPUtils::decibelsToLinear(threshold);
+    c.inverseThreshold = 1.0f / c.thresholdLinear;
+
+    // Very fast attack (0.1ms) for limiting
+    c.attackCoeff = DSPUtils::calculateCoefficient(currentSampleRate, 0.1f);
+    // Moderate release (50ms)
+    c.releaseCoeff = DSPUtils::calculateCoefficient(currentSampleRate, 50.0f);
+
+    c.bypassed = bypassed;
+
+    c.lookahead = lookahead;
+    c.lookaheadSamples = calculateLookaheadSamples(currentSampleRate);
+
+    coefficients.publish(c);
 }
 
 void NeveLimiter::setThreshold(float thresholdDb)
 {
     threshold = std::clamp(thresholdDb, -20.0f, 0.0f);
-    thresholdLinear = DSPUtils::decibelsToLinear(threshold);
+    updateCoefficients();
 }
 
-void NeveLimiter::process(juce::AudioBuffer<float>& buffer)
+void NeveLimiter::softClip(float* data, int numSamples, float thresholdLinear)
 {
-    if (bypassed)
-        return;
+    using SIMD::Float4;
+
+    // Samples past 1.1x threshold take the tanh curve; computed for every
+    // sample and selected, so dense clipping costs the same as none
+    const float inverseThreshold = 1.0f / thresholdLinear;
+    const float knee = thresholdLinear * 1.1f;
+
+    const Float4 threshold4 = Float4::broadcast(thresholdLinear);
+    const Float4 inverseThreshold4 = Float4::broadcast(inverseThreshold);
+    const Float4 knee4 = Float4::broadcast(knee);
+    const Float4 zero = Float4::broadcast(0.0f);
+
+    int i = 0;
+    for (; i + 4 <= numSamples; i += 4)
+    {
+        const Float4 x = Float4::load(data + i);
+        const Float4 magnitude = max(x, zero - x);
+        const Float4 clipped = DSPUtils::fastTanh(x * inverseThreshold4) * threshold4;
+
+        select(lessThan(knee4, magnitude), clipped, x).store(data + i);
+    }
+
+    for (; i < numSamples; ++i)
+    {
+        const float clipped = DSPUtils::fastTanh(data[i] * inverseThreshold) * thresholdLinear;
+        data[i] = std::abs(data[i]) > knee ? clipped : data[i];
+    }
+}
+
+void NeveLimiter::process(AudioSpan buffer)
+{
+    coefficients.pull();
+    const Coefficients& c = coefficients.current();
 
     const int numChannels = buffer.getNumChannels();
     const int numSamples = buffer.getNumSamples();
@@ -41,60 +147,282 @@ void NeveLimiter::process(juce::AudioBuffer<float>& buffer)
     if (numChannels == 0)
         return;
 
+    const int stages = oversampler.beginBlock();
+
+    if (!c.lookahead)
+        activeLookahead = 0;
+
+    if (c.bypassed && stages == 0 && !c.lookahead)
+    {
+        gainReductionStats.store({});
+        return;
+    }
+
     float* left = buffer.getWritePointer(0);
     float* right = numChannels > 1 ? buffer.getWritePointer(1) : nullptr;
 
-    float maxGR = 0.0f;
+    GainStats stats;
 
-    for (int i = 0; i < numSamples; ++i)
+    if (c.lookahead)
+    {
+        // Buffers are sized in prepare() for this ramp length
+        if (activeLookahead != c.lookaheadSamples)
+            resetLookahead(c.lookaheadSamples);
+        else if (detectorIdle && !c.bypassed)
+            resetLookaheadDetector();   // Its history is stale; the delayed audio stays
+        detectorIdle = c.bypassed;
+
+        stats = processLookahead(left, right, numSamples, c);
+    }
+    else if (!c.bypassed)
+    {
+        stats = processClassic(left, right, numSamples, c);
+    }
+
+    // Metering: this block's statistics, converted once and published as one word
+    if (c.bypassed || stats.count == 0)
+        gainReductionStats.store({});
+    else
+        gainReductionStats.store({ std::abs(DSPUtils::linearToDecibels(stats.highest)),
+                                   std::abs(DSPUtils::linearToDecibels(stats.lowest)),
+                                   std::abs(DSPUtils::linearToDecibels(stats.sum / static_cast<float>(stats.count))) });
+
+    // Bypassed: still run the resampling filters so the reported latency holds
+    const bool clip = !c.bypassed;
+
+    // The clipper is the only nonlinearity fast enough to alias
+    if (stages == 0)
     {
-        float inputL = left[i];
-        float inputR = right ? right[i] : inputL;
-
-        // Peak detection
-        float peakL = std::abs(inputL);
-        float peakR = std::abs(inputR);
-        float peak = std::max(peakL, peakR);
-
-        // Envelope follower
-        if (peak > envelopeL)
-            envelopeL += attackCoeff * (peak - envelopeL);
-        else
-            envelopeL += releaseCoeff * (peak - envelopeL);
-
-        // Calculate gain reduction
-        float gain = 1.0f;
-        if (envelopeL > thresholdLinear)
+        if (clip)
+        {
+            softClip(left, numSamples, c.thresholdLinear);
+            if (right)
+                softClip(right, numSamples, c.thresholdLinear);
+        }
+        return;
+    }
+
+    for (int start = 0; start < numSamples; start += Oversampler::maxBlockSize)
+    {
+        const int n = std::min(Oversampler::maxBlockSize, numSamples - start);
+
+        oversampler.upsample(left + start, right != nullptr ? right + start : nullptr, n);
+
+        if (clip)
         {
-            gain = thresholdLinear / envelopeL;
+            softClip(oversampler.getOversampledChannel(0), n << stages, c.thresholdLinear);
+            if (right)
+                softClip(oversampler.getOversampledChannel(1), n << stages, c.thresholdLinear);
+        }
+
+        oversampler.downsample(left + start, right != nullptr ? right + start : nullptr, n);
+    }
+}
+
+void NeveLimiter::detectEnvelope(const float* left, const float* right, int numSamples,
+                                 const Coefficients& c)
+{
+    float level = envelope;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // Linked peak detection
+        const float peak = std::max(std::abs(left[i]), std::abs(right[i]));
+
+        // Envelope follower; the coefficient choice compiles to a select
+        const float coeff = peak > level ? c.attackCoeff : c.releaseCoeff;
+        level += coeff * (peak - level);
+
+        envelopeBuffer[i] = level;
+    }
+
+    envelope = level;
+
+    // Repeat the last envelope into the padding so it can't widen the GR range
+    for (int i = numSamples; (i & 3) != 0; ++i)
+        envelopeBuffer[i] = level;
+}
+
+NeveLimiter::GainStats NeveLimiter::computeGains(const float* levels, float* gains, int numSamples,
+                                const Coefficients& c)
+{
+    using SIMD::Float4;
+
+    const Float4 zero = Float4::broadcast(0.0f);
+    const Float4 half = Float4::broadcast(0.5f);
+    const Float4 one = Float4::broadcast(1.0f);
+    const Float4 softOnset = Float4::broadcast(1.5f);
+    const Float4 thresholdLinear = Float4::broadcast(c.thresholdLinear);
+    const Float4 inverseThreshold = Float4::broadcast(c.inverseThreshold);
 
-            // Soft saturation on the gain reduction for more musical limiting
-            // This mimics diode bridge behavior
-            float overRatio = envelopeL / thresholdLinear;
-            if (overRatio > 1.5f)
+    const Float4 four = Float4::broadcast(4.0f);
+    const Float4 laneIndex = Float4::fromValues(0.0f, 1.0f, 2.0f, 3.0f);
+
+    Float4 minGain = one;
+    Float4 maxGain = zero;
+    Float4 sumGain = zero;
+    Float4 remaining = Float4::broadcast(static_cast<float>(numSamples));
+
+    // Buffers are padded to a whole number of Float4s
+    for (int i = 0; i < numSamples; i += 4)
+    {
+        const Float4 level = Float4::load(levels + i);
+
+        // Above 1.5x threshold the reduction deepens by 1 / (1 + excess / 2),
+        // mimicking the diode bridge on extreme overs
+        const Float4 excess = max(level * inverseThreshold - softOnset, zero);
+        const Float4 effectiveLevel = level * (one + excess * half);
+
+        // threshold / level above threshold, unity below (excess is 0 there)
+        const Float4 gain = thresholdLinear / max(effectiveLevel, thresholdLinear);
+        minGain = min(minGain, gain);
+        maxGain = max(maxGain, gain);
+
+        // Padding lanes repeat the last envelope: harmless to the extremes,
+        // masked out of the sum
+        sumGain = sumGain + select(lessThan(laneIndex, remaining), gain, zero);
+        remaining = remaining - four;
+
+        gain.store(gains + i);
+    }
+
+    return { minGain.horizontalMin(), maxGain.horizontalMax(), sumGain.horizontalSum(), numSamples };
+}
+
+// Pass 3: samples *= gains
+static void applyGains(float* samples, const float* gains, int numSamples)
+{
+    using SIMD::Float4;
+
+    int i = 0;
+    for (; i + 4 <= numSamples; i += 4)
+        (Float4::load(samples + i) * Float4::load(gains + i)).store(samples + i);
+
+    for (; i < numSamples; ++i)
+        samples[i] *= gains[i];
+}
+
+NeveLimiter::GainStats NeveLimiter::processClassic(float* left, float* right, int numSamples, const Coefficients& c)
+{
+    GainStats stats;
+
+    for (int start = 0; start < numSamples; start += chunkSize)
+    {
+        const int n = std::min(chunkSize, numSamples - start);
+
+        // Mono runs with right aliased to left
+        detectEnvelope(left + start, (right != nullptr ? right : left) + start, n, c);
+        stats.include(computeGains(envelopeBuffer, gainBuffer, n, c));
+
+        applyGains(left + start, gainBuffer, n);
+        if (right != nullptr)
+            applyGains(right + start, gainBuffer, n);
+    }
+
+    return stats;
+}
+
+NeveLimiter::GainStats NeveLimiter::processLookahead(float* left, float* right, int numSamples, const Coefficients& c)
+{
+    const int lookaheadSamples = activeLookahead;
+    const int delay = lookaheadSamples + TruePeakDetector::latencySamples - 1;
+    const uint32_t windowLength = static_cast<uint32_t>(lookaheadSamples);
+    const float rampScale = 1.0f / static_cast<float>(lookaheadSamples);
+    const float thresholdLinear = c.thresholdLinear;
+
+    float* delayL = delayLine[0].data();
+    float* delayR = delayLine[1].data();
+
+    GainStats stats;
+
+    alignas(16) float peaksL[chunkSize];
+    alignas(16) float peaksR[chunkSize];
+
+    for (int start = 0; start < numSamples; start += chunkSize)
+    {
+        const int n = std::min(chunkSize, numSamples - start);
+        float* blockL = left + start;
+        float* blockR = right != nullptr ? right + start : nullptr;
+
+        // Bypassed: the delay line alone, so the latency holds
+        if (c.bypassed)
+        {
+            for (int i = 0; i < n; ++i)
             {
-                // Add soft clipping character for extreme limiting
-                float excess = overRatio - 1.5f;
-                gain *= (1.0f / (1.0f + excess * 0.5f));
+                const int read = (delayWrite - delay) & delayMask;
+                delayL[delayWrite] = blockL[i];
+                blockL[i] = delayL[read];
+
+                if (blockR)
+                {
+                    delayR[delayWrite] = blockR[i];
+                    blockR[i] = delayR[read];
+                }
+
+                delayWrite = (delayWrite + 1) & delayMask;
             }
+            continue;
+        }
+
+        stats.count += n;
+
+        // 4x true peaks of the undelayed input, linked across channels
+        truePeak[0].process(blockL, peaksL, n);
+        if (blockR)
+        {
+            truePeak[1].process(blockR, peaksR, n);
+            for (int i = 0; i < n; ++i)
+                peaksL[i] = std::max(peaksL[i], peaksR[i]);
         }
 
-        // Track GR for metering
-        float gr = DSPUtils::linearToDecibels(gain);
-        if (std::abs(gr) > maxGR)
-            maxGR = std::abs(gr);
-
-        // Apply limiting
-        left[i] = inputL * gain;
-        if (right)
-            right[i] = inputR * gain;
-
-        // Final soft clip safety (prevents any overs)
-        if (std::abs(left[i]) > thresholdLinear * 1.1f)
-            left[i] = std::tanh(left[i] / thresholdLinear) * thresholdLinear;
-        if (right && std::abs(right[i]) > thresholdLinear * 1.1f)
-            right[i] = std::tanh(right[i] / thresholdLinear) * thresholdLinear;
+        for (int i = 0; i < n; ++i)
+        {
+            // Sliding-window maximum over the lookahead: a monotonic deque,
+            // each peak pushed and popped at most once
+            const float peak = peaksL[i];
+            while (windowBack != windowFront && peakWindow[(windowBack - 1) & windowMask].peak <= peak)
+                --windowBack;
+            peakWindow[windowBack++ & windowMask] = { sampleTime, peak };
+
+            // Times are consecutive, so at most one entry expires per sample
+            if (sampleTime - peakWindow[windowFront & windowMask].time >= windowLength)
+                ++windowFront;
+            ++sampleTime;
+
+            const float windowPeak = peakWindow[windowFront & windowMask].peak;
+
+            // Gain this window needs: taken at once, released smoothly
+            const float target = windowPeak > thresholdLinear ? thresholdLinear / windowPeak : 1.0f;
+            if (target < releaseEnvelope)
+                releaseEnvelope = target;
+            else
+                releaseEnvelope += c.releaseCoeff * (target - releaseEnvelope);
+
+            // Moving average over the lookahead turns each step into a
+            // linear ramp that is complete when the peak leaves the delay
+            rampSum += static_cast<double>(releaseEnvelope - rampHistory[static_cast<size_t>(rampPosition)]);
+            rampHistory[static_cast<size_t>(rampPosition)] = releaseEnvelope;
+            rampPosition = rampPosition + 1 == lookaheadSamples ? 0 : rampPosition + 1;
+
+            const float gain = static_cast<float>(rampSum) * rampScale;
+            stats.lowest = std::min(stats.lowest, gain);
+            stats.highest = std::max(stats.highest, gain);
+            stats.sum += gain;
+
+            // Delay line
+            const int read = (delayWrite - delay) & delayMask;
+            delayL[delayWrite] = blockL[i];
+            blockL[i] = delayL[read] * gain;
+
+            if (blockR)
+            {
+                delayR[delayWrite] = blockR[i];
+                blockR[i] = delayR[read] * gain;
+            }
+
+            delayWrite = (delayWrite + 1) & delayMask;
+        }
     }
 
-    currentGainReduction = maxGR;
+    return stats;
 }
@@ -1,6 +1,12 @@
 #pragma once
 
-#include <JuceHeader.h>
+#include "AudioSpan.h"
+#include "SnapshotExchange.h"
+#include "GainReductionStats.h"
+#include "Oversampler.h"
+#include "TruePeakDetector.h"
+#include <algorithm>
+#include <vector>
 
 /**
  * Neve-style Limiter
@@ -10,6 +16,17 @@
  * - Fast-acting limiting with musical character
  * - Soft clipping at threshold
  * - Minimal artifacts
+ * - Branch-free block pipeline: envelope pass, then 4-wide gain law and
+ *   gain apply passes; GR is metered from the block's smallest, largest
+ *   and mean linear gain
+ * - Optional 2x/4x/8x oversampling of the safety clipper (the gain
+ *   computer stays at the host rate)
+ * - Lookahead true-peak mode: the audio is delayed while the gain ramps
+ *   down ahead of every 4x-oversampled peak, so nothing overshoots the
+ *   threshold and the safety clipper has nothing left to do
+ *
+ * Threading: setters run on one non-realtime thread and publish a
+ * Coefficients snapshot; process() adopts the newest one per block.
  */
 class NeveLimiter
 {
@@ -17,32 +34,127 @@ public:
     NeveLimiter();
 
     void prepare(double sampleRate, int samplesPerBlock);
-    void process(juce::AudioBuffer<float>& buffer);
+    void process(AudioSpan buffer);
     void reset();
 
     // Threshold in dB (-20 to 0)
     void setThreshold(float thresholdDb);
 
     // Bypass
-    void setBypass(bool shouldBypass) { bypassed = shouldBypass; }
+    void setBypass(bool shouldBypass) { bypassed = shouldBypass; updateCoefficients(); }
     bool isBypassed() const { return bypassed; }
 
-    // Metering
-    float getGainReduction() const { return currentGainReduction; }
+    // Lookahead true-peak mode
+    void setLookahead(bool shouldUseLookahead) { lookahead = shouldUseLookahead; updateCoefficients(); }
+
+    // Delay added by the current mode (the lookahead delay line runs even when bypassed)
+    int getLatencySamples() const;
+
+    // Oversampling: 0-3 stages (1x-8x), any thread
+    void setOversampling(int numStages, Oversampler::Mode mode) { oversampler.setConfiguration(numStages, mode); }
+
+    // Metering, any thread: the last block's GR statistics (dB; the mean is
+    // that of the linear gain), and its deepest GR
+    GainReductionStats getGainReductionStats() const { return gainReductionStats.load(); }
+    float getGainReduction() const { return gainReductionStats.load().maximum; }
+
+    // Everything process() reads, derived off the audio thread
+    struct Coefficients
+    {
+        float thresholdLinear = 1.0f;
+        float inverseThreshold = 1.0f;
+        float attackCoeff = 0.0f;
+        float releaseCoeff = 0.0f;
+        bool bypassed = false;
+
+        bool lookahead = false;
+        int lookaheadSamples = 0;    // Gain ramp length = sliding window length
+    };
 
 private:
+    void updateCoefficients();
+
+    static int calculateLookaheadSamples(double sampleRate);
+
+    static constexpr int chunkSize = 256;
+
+    // Linear gain statistics over one or more passes
+    struct GainStats
+    {
+        float lowest = 1.0f;
+        float highest = 0.0f;
+        float sum = 0.0f;
+        int count = 0;
+
+        void include(const GainStats& other)
+        {
+            lowest = std::min(lowest, other.lowest);
+            highest = std::max(highest, other.highest);
+            sum += other.sum;
+            count += other.count;
+        }
+    };
+
+    // Envelope follower gain pass in place; returns the gain statistics
+    GainStats processClassic(float* left, float* right, int numSamples, const Coefficients& c);
+
+    // Pass 1: linked peak envelope into envelopeBuffer (right may alias left)
+    void detectEnvelope(const float* left, const float* right, int numSamples, const Coefficients& c);
+
+    // Pass 2: envelope -> linear gain; returns the gain statistics
+    static GainStats computeGains(const float* levels, float* gains, int numSamples, const Coefficients& c);
+
+    // Lookahead mode gain pass in place; returns the gain statistics
+    GainStats processLookahead(float* left, float* right, int numSamples, const Coefficients& c);
+    void resetLookahead(int lookaheadSamples);
+    // Detector side only (window, ramp, release, true-peak); the delay line keeps its audio
+    void resetLookaheadDetector();
+
+    // Final soft clip safety (prevents any overs)
+    static void softClip(float* data, int numSamples, float thresholdLinear);
+
     double currentSampleRate = 44100.0;
     bool bypassed = false;
+    bool lookahead = false;
 
     float threshold = 0.0f;        // dB
-    float thresholdLinear = 1.0f;  // Linear
-    float currentGainReduction = 0.0f;
+    AtomicGainReductionStats gainReductionStats;
+
+    // Published to the audio thread
+    SnapshotExchange<Coefficients> coefficients;
 
     // State
-    float envelopeL = 0.0f;
-    float envelopeR = 0.0f;
+    float envelope = 0.0f;
+
+    // Per-chunk working buffers, padded to whole Float4s
+    alignas(16) float envelopeBuffer[chunkSize] {};
+    alignas(16) float gainBuffer[chunkSize] {};
+
+    Oversampler oversampler;
+
+    // Lookahead state, sized in prepare() for the longest ramp at that rate
+    static constexpr float lookaheadMs = 1.5f;
+
+    struct PeakEntry
+    {
+        uint32_t time;
+        float peak;
+    };
+
+    TruePeakDetector truePeak[2];
+    std::vector<float> delayLine[2];         // Power-of-two ring buffers
+    int delayMask = 0;
+    int delayWrite = 0;
+
+    std::vector<PeakEntry> peakWindow;       // Monotonic deque: peaks decreasing from front to back
+    uint32_t windowMask = 0;
+    uint32_t windowFront = 0, windowBack = 0;
+    uint32_t sampleTime = 0;
 
-    // Very fast attack for limiting
-    float attackCoeff = 0.0f;
-    float releaseCoeff = 0.0f;
+    std::vector<float> rampHistory;          // Moving average over lookaheadSamples
+    double rampSum = 0.0;
+    int rampPosition = 0;
+    float releaseEnvelope = 1.0f;
+    int activeLookahead = 0;                 // Ramp length the state was set up for (0 = not running)
+    bool detectorIdle = false;               // Last lookahead block ran the delay line alone
 };
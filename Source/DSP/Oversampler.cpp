@@ -0,0 +1,438 @@
+#include "Oversampler.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    constexpr double pi = 3.14159265358979323846;
+
+    // Filter design for one 2x stage. Later stages only have to reject
+    // images of an already band-limited signal, so their transition bands
+    // are much wider and their filters much shorter.
+    struct StageDesign
+    {
+        // Allpass coefficients, alternating path 0 / path 1
+        int numAllpass = 0;
+        double allpass[2 * 4] {};
+
+        // Half-band FIR: 4M+3 taps, the 2M+2 even-indexed ones are nonzero
+        int centreDelay = 0;                                  // M
+        int numTaps = 0;                                      // 2M+2 rounded up to a multiple of 4
+        alignas(16) float upTaps[64] {};                      // Oldest first, x2 for the upsampler
+        alignas(16) float downTaps[64] {};
+    };
+
+    // Polyphase allpass half-band design (elliptic, after Laurent de Soras' HIIR)
+    // transition: transition band width relative to the oversampled rate
+    void designAllpass(StageDesign& d, int numCoefficients, double transition)
+    {
+        double k = std::tan((1.0 - transition * 2.0) * pi / 4.0);
+        k *= k;
+        const double kksqrt = std::pow(1.0 - k * k, 0.25);
+        const double e = 0.5 * (1.0 - kksqrt) / (1.0 + kksqrt);
+        const double e4 = e * e * e * e;
+        const double q = e * (1.0 + e4 * (2.0 + e4 * (15.0 + 150.0 * e4)));
+
+        const int order = numCoefficients * 2 + 1;
+
+        for (int index = 0; index < numCoefficients; ++index)
+        {
+            const int c = index + 1;
+
+            double num = 0.0, term = 0.0;
+            int sign = 1;
+            for (int i = 0; i == 0 || std::abs(term) > 1.0e-100; ++i, sign = -sign)
+            {
+                term = std::pow(q, i * (i + 1)) * std::sin((i * 2 + 1) * c * pi / order) * sign;
+                num += term;
+            }
+
+            double den = 0.0;
+            sign = -1;
+            for (int i = 1; i == 1 || std::abs(term) > 1.0e-100; ++i, sign = -sign)
+            {
+                term = std::pow(q, i * i) * std::cos(i * 2 * c * pi / order) * sign;
+                den += term;
+            }
+
+            const double ww = num * std::pow(q, 0.25) / (den + 0.5);
+            const double wwsq = ww * ww;
+            const double x = std::sqrt((1.0 - wwsq * k) * (1.0 - wwsq / k)) / (1.0 + wwsq);
+            d.allpass[index] = (1.0 - x) / (1.0 + x);
+        }
+
+        d.numAllpass = numCoefficients;
+    }
+
+    double besselI0(double x)
+    {
+        double sum = 1.0, term = 1.0;
+        for (int k = 1; k < 60; ++k)
+        {
+            term *= (x / (2.0 * k)) * (x / (2.0 * k));
+            sum += term;
+        }
+        return sum;
+    }
+
+    // Kaiser-windowed sinc half-band of length 4M+3
+    void designFir(StageDesign& d, int m, double beta)
+    {
+        const int length = 4 * m + 3;
+        const int centre = 2 * m + 1;
+        const int nonzero = 2 * m + 2;
+
+        double h[4 * 31 + 3] {};
+        double evenSum = 0.0;
+
+        for (int k = 0; k < length; k += 2)
+        {
+            const int offset = k - centre;                     // Always odd
+            const double r = static_cast<double>(offset) / (centre + 1);
+            const double window = besselI0(beta * std::sqrt(std::max(0.0, 1.0 - r * r))) / besselI0(beta);
+            h[k] = std::sin(pi * offset / 2.0) / (pi * offset) * window;
+            evenSum += h[k];
+        }
+
+        d.centreDelay = m;
+        d.numTaps = (nonzero + 3) & ~3;
+
+        // Normalise the even taps to 0.5 (plus the 0.5 centre tap = unity DC gain),
+        // then store oldest first so a window of history lines up with the taps
+        for (int j = 0; j < d.numTaps; ++j)
+        {
+            const int delay = d.numTaps - 1 - j;
+            const double tap = delay < nonzero ? h[2 * delay] * 0.5 / evenSum : 0.0;
+            d.downTaps[j] = static_cast<float>(tap);
+            d.upTaps[j] = static_cast<float>(2.0 * tap);
+        }
+    }
+
+    const StageDesign& getDesign(int stage)
+    {
+        static const auto designs = []
+        {
+            std::array<StageDesign, Oversampler::maxStages> d {};
+
+            // 2x: 20 kHz passband at 44.1 kHz, >= 90 dB stopband
+            designAllpass(d[0], 8, 0.045);
+            designFir(d[0], 29, 9.0);
+
+            // 4x, 8x
+            designAllpass(d[1], 4, 0.27);
+            designFir(d[1], 5, 10.0);
+
+            designAllpass(d[2], 2, 0.38);
+            designFir(d[2], 5, 10.0);
+
+            return d;
+        }();
+
+        return designs[static_cast<size_t>(stage)];
+    }
+
+    int packConfiguration(int numStages, Oversampler::Mode mode) { return numStages | (static_cast<int>(mode) << 4); }
+}
+
+//==============================================================================
+Oversampler::Oversampler()
+{
+    for (int s = 0; s < maxStages; ++s)
+    {
+        const StageDesign& design = getDesign(s);
+        Stage& stage = stages[s];
+
+        for (auto* allpass : { &stage.allpassUp, &stage.allpassDown })
+        {
+            allpass->numSections = design.numAllpass / 2;
+            for (int k = 0; k < allpass->numSections; ++k)
+            {
+                const float a0 = static_cast<float>(design.allpass[2 * k]);
+                const float a1 = static_cast<float>(design.allpass[2 * k + 1]);
+                allpass->coefficients[k] = SIMD::Float4::fromValues(a0, a0, a1, a1);
+            }
+        }
+
+        // Stage s upsamples maxBlockSize << s samples; its downsampler sees
+        // the same count per phase
+        const size_t historySize = static_cast<size_t>(FirHalfBand::maxTaps + (maxBlockSize << s));
+
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            for (auto* fir : { &stage.firUp[ch], &stage.firDown[ch] })
+            {
+                fir->numTaps = design.numTaps;
+                fir->centreDelay = design.centreDelay;
+                fir->taps = design.upTaps;
+                fir->downTaps = design.downTaps;
+                fir->history.assign(historySize, 0.0f);
+            }
+            stage.firDown[ch].oddHistory.assign(historySize, 0.0f);
+        }
+    }
+
+    for (auto& channel : buffers)
+        for (auto& buffer : channel)
+            buffer.assign(static_cast<size_t>(maxBlockSize << maxStages), 0.0f);
+
+    output[0] = buffers[0][0].data();
+    output[1] = buffers[1][0].data();
+}
+
+void Oversampler::setConfiguration(int stagesToUse, Mode filterMode)
+{
+    requestedConfiguration.store(packConfiguration(std::clamp(stagesToUse, 0, maxStages), filterMode),
+                                 std::memory_order_release);
+}
+
+float Oversampler::getLatencySamples(int stagesToUse, Mode filterMode)
+{
+    double latency = 0.0;
+
+    for (int s = 0; s < std::clamp(stagesToUse, 0, maxStages); ++s)
+    {
+        const StageDesign& design = getDesign(s);
+        double stageDelay;    // Up + down, in samples at this stage's output rate
+
+        if (filterMode == MODE_FIR)
+        {
+            stageDelay = 4.0 * design.centreDelay + 2.0;
+        }
+        else
+        {
+            // DC group delay: each path's first-order sections contribute
+            // (1 - a) / (1 + a) low-rate samples, path 1 one extra high-rate
+            // sample, and the half-band averages the two paths
+            double pathDelay[2] {};
+            for (int k = 0; k < design.numAllpass; ++k)
+                pathDelay[k & 1] += 2.0 * (1.0 - design.allpass[k]) / (1.0 + design.allpass[k]);
+
+            stageDelay = 2.0 * 0.5 * (pathDelay[0] + pathDelay[1] + 1.0);
+        }
+
+        latency += stageDelay / static_cast<double>(2 << s);
+    }
+
+    return static_cast<float>(latency);
+}
+
+void Oversampler::reset()
+{
+    for (auto& stage : stages)
+    {
+        stage.allpassUp.reset();
+        stage.allpassDown.reset();
+
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            stage.firUp[ch].reset();
+            stage.firDown[ch].reset();
+        }
+    }
+}
+
+int Oversampler::beginBlock()
+{
+    const int requested = requestedConfiguration.load(std::memory_order_acquire);
+
+    if (requested != activeConfiguration)
+    {
+        activeConfiguration = requested;
+        numStages = requested & 15;
+        mode = static_cast<Mode>(requested >> 4);
+        reset();
+    }
+
+    return numStages;
+}
+
+void Oversampler::upsample(const float* left, const float* right, int numSamples)
+{
+    const float* inL = left;
+    const float* inR = right;
+    int n = numSamples;
+
+    for (int s = 0; s < numStages; ++s)
+    {
+        float* outL = buffers[0][s & 1].data();
+        float* outR = right != nullptr ? buffers[1][s & 1].data() : nullptr;
+
+        if (mode == MODE_IIR)
+        {
+            stages[s].allpassUp.upsample(inL, inR, outL, outR, n);
+        }
+        else
+        {
+            stages[s].firUp[0].upsample(inL, outL, n);
+            if (outR != nullptr)
+                stages[s].firUp[1].upsample(inR, outR, n);
+        }
+
+        inL = outL;
+        inR = outR;
+        n *= 2;
+    }
+
+    output[0] = buffers[0][(numStages - 1) & 1].data();
+    output[1] = buffers[1][(numStages - 1) & 1].data();
+}
+
+void Oversampler::downsample(float* left, float* right, int numSamples)
+{
+    // In place down to the last stage, which writes the host block
+    float* inL = output[0];
+    float* inR = right != nullptr ? output[1] : nullptr;
+    int n = numSamples << numStages;
+
+    for (int s = numStages - 1; s >= 0; --s)
+    {
+        n /= 2;
+        float* outL = s == 0 ? left : inL;
+        float* outR = s == 0 ? right : inR;
+
+        if (mode == MODE_IIR)
+        {
+            stages[s].allpassDown.downsample(inL, inR, outL, outR, n);
+        }
+        else
+        {
+            stages[s].firDown[0].downsample(inL, outL, n);
+            if (outR != nullptr)
+                stages[s].firDown[1].downsample(inR, outR, n);
+        }
+    }
+}
+
+//==============================================================================
+void Oversampler::AllpassHalfBand::reset()
+{
+    for (int k = 0; k < maxSections; ++k)
+        x1[k] = y1[k] = SIMD::Float4::broadcast(0.0f);
+}
+
+void Oversampler::AllpassHalfBand::upsample(const float* inL, const float* inR, float* outL, float* outR,
+                                            int numSamples)
+{
+    using SIMD::Float4;
+
+    // Mono runs with right aliased to left; its lanes are simply not stored
+    if (inR == nullptr)
+        inR = inL;
+
+    alignas(16) float lanes[4];
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // Both paths see the same input: {L, R, L, R}
+        Float4 x = Float4::fromValues(inL[i], inR[i], inL[i], inR[i]);
+
+        for (int k = 0; k < numSections; ++k)
+        {
+            const Float4 y = coefficients[k] * (x - y1[k]) + x1[k];
+            x1[k] = x;
+            y1[k] = y;
+            x = y;
+        }
+
+        // Path 0 -> even output sample, path 1 -> odd
+        x.store(lanes);
+        outL[2 * i] = lanes[0];
+        outL[2 * i + 1] = lanes[2];
+
+        if (outR != nullptr)
+        {
+            outR[2 * i] = lanes[1];
+            outR[2 * i + 1] = lanes[3];
+        }
+    }
+}
+
+void Oversampler::AllpassHalfBand::downsample(const float* inL, const float* inR, float* outL, float* outR,
+                                              int numSamples)
+{
+    using SIMD::Float4;
+
+    if (inR == nullptr)
+        inR = inL;
+
+    alignas(16) float lanes[4];
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // Path 0 takes the odd input sample, path 1 the even one
+        Float4 x = Float4::fromValues(inL[2 * i + 1], inR[2 * i + 1], inL[2 * i], inR[2 * i]);
+
+        for (int k = 0; k < numSections; ++k)
+        {
+            const Float4 y = coefficients[k] * (x - y1[k]) + x1[k];
+            x1[k] = x;
+            y1[k] = y;
+            x = y;
+        }
+
+        x.store(lanes);
+        outL[i] = 0.5f * (lanes[0] + lanes[2]);
+
+        if (outR != nullptr)
+            outR[i] = 0.5f * (lanes[1] + lanes[3]);
+    }
+}
+
+//==============================================================================
+void Oversampler::FirHalfBand::reset()
+{
+    std::fill(history.begin(), history.end(), 0.0f);
+    std::fill(oddHistory.begin(), oddHistory.end(), 0.0f);
+}
+
+static inline float dotProduct(const float* a, const float* b, int numTaps)
+{
+    using SIMD::Float4;
+
+    Float4 sum = Float4::broadcast(0.0f);
+    for (int j = 0; j < numTaps; j += 4)
+        sum = sum + Float4::load(a + j) * Float4::load(b + j);
+
+    return sum.horizontalSum();
+}
+
+void Oversampler::FirHalfBand::upsample(const float* input, float* out, int numSamples)
+{
+    float* h = history.data();
+    std::memcpy(h + numTaps, input, sizeof(float) * static_cast<size_t>(numSamples));
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // numTaps samples ending with the current one
+        const float* window = h + i + 1;
+
+        out[2 * i] = dotProduct(window, taps, numTaps);
+        out[2 * i + 1] = window[numTaps - 1 - centreDelay];    // Centre tap: a pure delay
+    }
+
+    std::memmove(h, h + numSamples, sizeof(float) * static_cast<size_t>(numTaps));
+}
+
+void Oversampler::FirHalfBand::downsample(const float* input, float* out, int numSamples)
+{
+    float* even = history.data();
+    float* odd = oddHistory.data();
+
+    // Split the phases first, so input and output may share a buffer
+    for (int i = 0; i < numSamples; ++i)
+    {
+        even[numTaps + i] = input[2 * i];
+        odd[numTaps + i] = input[2 * i + 1];
+    }
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float* window = even + i + 1;
+        out[i] = dotProduct(window, downTaps, numTaps) + 0.5f * odd[numTaps + i - centreDelay - 1];
+    }
+
+    std::memmove(even, even + numSamples, sizeof(float) * static_cast<size_t>(numTaps));
+    std::memmove(odd, odd + numSamples, sizeof(float) * static_cast<size_t>(numTaps));
+}
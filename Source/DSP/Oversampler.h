@@ -0,0 +1,108 @@
+#pragma once
+
+#include "SIMDTypes.h"
+#include <atomic>
+#include <vector>
+
+/**
+ * Polyphase Half-band Oversampler (1x/2x/4x/8x)
+ *
+ * Cascades up to three 2x half-band stages around a nonlinear stage:
+ * upsample() -> process the oversampled block in place -> downsample().
+ *
+ * - IIR: polyphase allpass pair (minimum phase, a few samples of delay).
+ *   Both allpass paths and both channels advance in one Float4.
+ * - FIR: Kaiser-windowed half-band (linear phase). Only the nonzero taps
+ *   are evaluated, as Float4 dot products over a linear history.
+ *
+ * Stage filters are designed once per process (they don't depend on the
+ * sample rate) and shared by every instance.
+ *
+ * Threading: setConfiguration() may be called from any thread; the audio
+ * thread adopts it in beginBlock() and starts the new filters from silence.
+ * Everything else is audio thread only.
+ */
+class Oversampler
+{
+public:
+    enum Mode { MODE_IIR = 0, MODE_FIR };
+
+    static constexpr int maxStages = 3;          // 8x
+    static constexpr int maxBlockSize = 256;     // Host-rate samples per upsample()/downsample()
+
+    Oversampler();
+
+    // Request 2^numStages oversampling with the given filter type
+    void setConfiguration(int numStages, Mode mode);
+
+    // Host-rate latency of a configuration (upsampler + downsampler)
+    static float getLatencySamples(int numStages, Mode mode);
+
+    void reset();
+
+    // Adopt a pending configuration; returns the active number of stages
+    int beginBlock();
+    int getNumStages() const { return numStages; }
+
+    // Host block (<= maxBlockSize samples) -> oversampled block; right may be nullptr for mono
+    void upsample(const float* left, const float* right, int numSamples);
+
+    // The oversampled block (numSamples << getNumStages() samples)
+    float* getOversampledChannel(int channel) { return output[channel]; }
+
+    // Oversampled block -> host block
+    void downsample(float* left, float* right, int numSamples);
+
+private:
+    // Minimum-phase half-band: two allpass paths, lanes {L path0, R path0, L path1, R path1}
+    struct AllpassHalfBand
+    {
+        static constexpr int maxSections = 4;    // Per path
+
+        void reset();
+        void upsample(const float* inL, const float* inR, float* outL, float* outR, int numSamples);
+        void downsample(const float* inL, const float* inR, float* outL, float* outR, int numSamples);
+
+        int numSections = 0;
+        SIMD::Float4 coefficients[maxSections] {};
+        SIMD::Float4 x1[maxSections] {};
+        SIMD::Float4 y1[maxSections] {};
+    };
+
+    // Linear-phase half-band, per channel
+    struct FirHalfBand
+    {
+        static constexpr int maxTaps = 64;       // Nonzero taps, padded to a multiple of 4
+
+        void reset();
+        void upsample(const float* input, float* output, int numSamples);
+        void downsample(const float* input, float* output, int numSamples);
+
+        int numTaps = 0;
+        int centreDelay = 0;                     // M: the centre tap sits M low-rate samples back
+        const float* taps = nullptr;             // Oldest first, upsampler gain of 2 folded in for up
+        const float* downTaps = nullptr;
+
+        // Linear histories (last numTaps samples + the current block)
+        std::vector<float> history;
+        std::vector<float> oddHistory;           // Downsampler: odd-phase samples
+    };
+
+    struct Stage
+    {
+        AllpassHalfBand allpassUp, allpassDown;
+        FirHalfBand firUp[2], firDown[2];
+    };
+
+    std::atomic<int> requestedConfiguration { 0 };
+    int activeConfiguration = 0;
+
+    int numStages = 0;
+    Mode mode = MODE_IIR;
+
+    Stage stages[maxStages];
+
+    // Ping-pong buffers per channel, maxBlockSize << maxStages each
+    std::vector<float> buffers[2][2];
+    float* output[2] { nullptr, nullptr };
+};
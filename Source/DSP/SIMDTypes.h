@@ -0,0 +1,366 @@
+#pragma once
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #include <emmintrin.h>
+ #define NEVESTRIP_SIMD_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+ #include <arm_neon.h>
+ #define NEVESTRIP_SIMD_NEON 1
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * Minimal SIMD wrappers for the DSP modules
+ *
+ * Float2 holds a stereo pair (lane 0 = left, lane 1 = right) so that
+ * both channels of a recursive filter advance in one register:
+ * - SSE2: lower two lanes of an __m128
+ * - NEON: float32x2_t
+ * - Scalar fallback for anything else
+ *
+ * Float4 holds four consecutive samples of one stream, for block-wide
+ * feed-forward passes (gain curves, gain apply). Loads/stores are
+ * unaligned. Float4 also exposes the exponent/mantissa split and
+ * power-of-two scaling that the fast log2/exp2 in DSPUtils build on.
+ *
+ * Comparisons return lane masks that are only meant for select().
+ */
+namespace SIMD
+{
+#if NEVESTRIP_SIMD_SSE2
+    struct Float2
+    {
+        __m128 v;
+
+        static Float2 broadcast(float x)                       { return { _mm_set1_ps(x) }; }
+        static Float2 load(const float* l, const float* r)     { return { _mm_unpacklo_ps(_mm_load_ss(l), _mm_load_ss(r)) }; }
+        static Float2 fromValues(float l, float r)             { return { _mm_setr_ps(l, r, 0.0f, 0.0f) }; }
+
+        void store(float* l, float* r) const
+        {
+            _mm_store_ss(l, v);
+            _mm_store_ss(r, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)));
+        }
+
+        float left() const  { return _mm_cvtss_f32(v); }
+        float right() const { return _mm_cvtss_f32(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1))); }
+
+        friend Float2 operator+(Float2 a, Float2 b) { return { _mm_add_ps(a.v, b.v) }; }
+        friend Float2 operator-(Float2 a, Float2 b) { return { _mm_sub_ps(a.v, b.v) }; }
+        friend Float2 operator*(Float2 a, Float2 b) { return { _mm_mul_ps(a.v, b.v) }; }
+
+        friend Float2 abs(Float2 a)                  { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v) }; }
+        friend Float2 min(Float2 a, Float2 b)        { return { _mm_min_ps(a.v, b.v) }; }
+        friend Float2 max(Float2 a, Float2 b)        { return { _mm_max_ps(a.v, b.v) }; }
+        friend Float2 lessThan(Float2 a, Float2 b)   { return { _mm_cmplt_ps(a.v, b.v) }; }
+        friend Float2 select(Float2 mask, Float2 ifTrue, Float2 ifFalse)
+        {
+            return { _mm_or_ps(_mm_and_ps(mask.v, ifTrue.v), _mm_andnot_ps(mask.v, ifFalse.v)) };
+        }
+    };
+
+    struct Float4
+    {
+        __m128 v;
+
+        static Float4 broadcast(float x)           { return { _mm_set1_ps(x) }; }
+        static Float4 load(const float* p)         { return { _mm_loadu_ps(p) }; }
+        static Float4 fromValues(float a, float b, float c, float d) { return { _mm_setr_ps(a, b, c, d) }; }
+        void store(float* p) const                 { _mm_storeu_ps(p, v); }
+
+        friend Float4 operator+(Float4 a, Float4 b) { return { _mm_add_ps(a.v, b.v) }; }
+        friend Float4 operator-(Float4 a, Float4 b) { return { _mm_sub_ps(a.v, b.v) }; }
+        friend Float4 operator*(Float4 a, Float4 b) { return { _mm_mul_ps(a.v, b.v) }; }
+        friend Float4 operator/(Float4 a, Float4 b) { return { _mm_div_ps(a.v, b.v) }; }
+
+        friend Float4 min(Float4 a, Float4 b)        { return { _mm_min_ps(a.v, b.v) }; }
+        friend Float4 max(Float4 a, Float4 b)        { return { _mm_max_ps(a.v, b.v) }; }
+        friend Float4 lessThan(Float4 a, Float4 b)   { return { _mm_cmplt_ps(a.v, b.v) }; }
+        friend Float4 select(Float4 mask, Float4 ifTrue, Float4 ifFalse)
+        {
+            return { _mm_or_ps(_mm_and_ps(mask.v, ifTrue.v), _mm_andnot_ps(mask.v, ifFalse.v)) };
+        }
+
+        float horizontalSum() const
+        {
+            __m128 m = _mm_add_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+            return _mm_cvtss_f32(_mm_add_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 0, 3, 2))));
+        }
+
+        float horizontalMin() const
+        {
+            __m128 m = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+            return _mm_cvtss_f32(_mm_min_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 0, 3, 2))));
+        }
+
+        float horizontalMax() const
+        {
+            __m128 m = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+            return _mm_cvtss_f32(_mm_max_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 0, 3, 2))));
+        }
+
+        // Unbiased exponent of a positive normal float, as a float
+        static Float4 exponent(Float4 x)
+        {
+            __m128i e = _mm_and_si128(_mm_srli_epi32(_mm_castps_si128(x.v), 23), _mm_set1_epi32(255));
+            return { _mm_cvtepi32_ps(_mm_sub_epi32(e, _mm_set1_epi32(127))) };
+        }
+
+        // Mantissa of a positive normal float, in [1, 2)
+        static Float4 mantissa(Float4 x)
+        {
+            __m128i m = _mm_and_si128(_mm_castps_si128(x.v), _mm_set1_epi32(0x007FFFFF));
+            return { _mm_castsi128_ps(_mm_or_si128(m, _mm_set1_epi32(0x3F800000))) };
+        }
+
+        // floor() for |x| < 2^31
+        static Float4 floor(Float4 x)
+        {
+            __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(x.v));
+            return { _mm_sub_ps(t, _mm_and_ps(_mm_cmplt_ps(x.v, t), _mm_set1_ps(1.0f))) };
+        }
+
+        // x * 2^n for integral n, by adding n to the exponent bits (no overflow checks)
+        static Float4 scaleByPowerOfTwo(Float4 x, Float4 n)
+        {
+            __m128i shifted = _mm_slli_epi32(_mm_cvttps_epi32(n.v), 23);
+            return { _mm_castsi128_ps(_mm_add_epi32(_mm_castps_si128(x.v), shifted)) };
+        }
+    };
+#elif NEVESTRIP_SIMD_NEON
+    struct Float2
+    {
+        float32x2_t v;
+
+        static Float2 broadcast(float x)                       { return { vdup_n_f32(x) }; }
+        static Float2 load(const float* l, const float* r)     { return { vld1_lane_f32(r, vld1_dup_f32(l), 1) }; }
+        static Float2 fromValues(float l, float r)             { return { vset_lane_f32(r, vdup_n_f32(l), 1) }; }
+
+        void store(float* l, float* r) const
+        {
+            vst1_lane_f32(l, v, 0);
+            vst1_lane_f32(r, v, 1);
+        }
+
+        float left() const  { return vget_lane_f32(v, 0); }
+        float right() const { return vget_lane_f32(v, 1); }
+
+        friend Float2 operator+(Float2 a, Float2 b) { return { vadd_f32(a.v, b.v) }; }
+        friend Float2 operator-(Float2 a, Float2 b) { return { vsub_f32(a.v, b.v) }; }
+        friend Float2 operator*(Float2 a, Float2 b) { return { vmul_f32(a.v, b.v) }; }
+
+        friend Float2 abs(Float2 a)                  { return { vabs_f32(a.v) }; }
+        friend Float2 min(Float2 a, Float2 b)        { return { vmin_f32(a.v, b.v) }; }
+        friend Float2 max(Float2 a, Float2 b)        { return { vmax_f32(a.v, b.v) }; }
+        friend Float2 lessThan(Float2 a, Float2 b)   { return { vreinterpret_f32_u32(vclt_f32(a.v, b.v)) }; }
+        friend Float2 select(Float2 mask, Float2 ifTrue, Float2 ifFalse)
+        {
+            return { vbsl_f32(vreinterpret_u32_f32(mask.v), ifTrue.v, ifFalse.v) };
+        }
+    };
+
+    struct Float4
+    {
+        float32x4_t v;
+
+        static Float4 broadcast(float x)           { return { vdupq_n_f32(x) }; }
+        static Float4 load(const float* p)         { return { vld1q_f32(p) }; }
+        static Float4 fromValues(float a, float b, float c, float d)
+        {
+            const float values[4] = { a, b, c, d };
+            return { vld1q_f32(values) };
+        }
+        void store(float* p) const                 { vst1q_f32(p, v); }
+
+        friend Float4 operator+(Float4 a, Float4 b) { return { vaddq_f32(a.v, b.v) }; }
+        friend Float4 operator-(Float4 a, Float4 b) { return { vsubq_f32(a.v, b.v) }; }
+        friend Float4 operator*(Float4 a, Float4 b) { return { vmulq_f32(a.v, b.v) }; }
+
+        friend Float4 operator/(Float4 a, Float4 b)
+        {
+           #if defined(__aarch64__) || defined(_M_ARM64)
+            return { vdivq_f32(a.v, b.v) };
+           #else
+            // ARMv7 has no vector divide: reciprocal estimate + two Newton steps
+            float32x4_t r = vrecpeq_f32(b.v);
+            r = vmulq_f32(r, vrecpsq_f32(b.v, r));
+            r = vmulq_f32(r, vrecpsq_f32(b.v, r));
+            return { vmulq_f32(a.v, r) };
+           #endif
+        }
+
+        friend Float4 min(Float4 a, Float4 b)        { return { vminq_f32(a.v, b.v) }; }
+        friend Float4 max(Float4 a, Float4 b)        { return { vmaxq_f32(a.v, b.v) }; }
+        friend Float4 lessThan(Float4 a, Float4 b)   { return { vreinterpretq_f32_u32(vcltq_f32(a.v, b.v)) }; }
+        friend Float4 select(Float4 mask, Float4 ifTrue, Float4 ifFalse)
+        {
+            return { vbslq_f32(vreinterpretq_u32_f32(mask.v), ifTrue.v, ifFalse.v) };
+        }
+
+        float horizontalSum() const
+        {
+            float32x2_t m = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+            return vget_lane_f32(vpadd_f32(m, m), 0);
+        }
+
+        float horizontalMin() const
+        {
+            float32x2_t m = vpmin_f32(vget_low_f32(v), vget_high_f32(v));
+            return vget_lane_f32(vpmin_f32(m, m), 0);
+        }
+
+        float horizontalMax() const
+        {
+            float32x2_t m = vpmax_f32(vget_low_f32(v), vget_high_f32(v));
+            return vget_lane_f32(vpmax_f32(m, m), 0);
+        }
+
+        // Unbiased exponent of a positive normal float, as a float
+        static Float4 exponent(Float4 x)
+        {
+            int32x4_t e = vandq_s32(vshrq_n_s32(vreinterpretq_s32_f32(x.v), 23), vdupq_n_s32(255));
+            return { vcvtq_f32_s32(vsubq_s32(e, vdupq_n_s32(127))) };
+        }
+
+        // Mantissa of a positive normal float, in [1, 2)
+        static Float4 mantissa(Float4 x)
+        {
+            int32x4_t m = vandq_s32(vreinterpretq_s32_f32(x.v), vdupq_n_s32(0x007FFFFF));
+            return { vreinterpretq_f32_s32(vorrq_s32(m, vdupq_n_s32(0x3F800000))) };
+        }
+
+        // floor() for |x| < 2^31
+        static Float4 floor(Float4 x)
+        {
+            float32x4_t t = vcvtq_f32_s32(vcvtq_s32_f32(x.v));
+            uint32x4_t below = vandq_u32(vcltq_f32(x.v, t), vreinterpretq_u32_f32(vdupq_n_f32(1.0f)));
+            return { vsubq_f32(t, vreinterpretq_f32_u32(below)) };
+        }
+
+        // x * 2^n for integral n, by adding n to the exponent bits (no overflow checks)
+        static Float4 scaleByPowerOfTwo(Float4 x, Float4 n)
+        {
+            int32x4_t shifted = vshlq_n_s32(vcvtq_s32_f32(n.v), 23);
+            return { vreinterpretq_f32_s32(vaddq_s32(vreinterpretq_s32_f32(x.v), shifted)) };
+        }
+    };
+#else
+    struct Float2
+    {
+        float l, r;
+
+        static Float2 broadcast(float x)                       { return { x, x }; }
+        static Float2 load(const float* lp, const float* rp)   { return { *lp, *rp }; }
+        static Float2 fromValues(float lv, float rv)           { return { lv, rv }; }
+
+        void store(float* lp, float* rp) const { *lp = l; *rp = r; }
+
+        float left() const  { return l; }
+        float right() const { return r; }
+
+        friend Float2 operator+(Float2 a, Float2 b) { return { a.l + b.l, a.r + b.r }; }
+        friend Float2 operator-(Float2 a, Float2 b) { return { a.l - b.l, a.r - b.r }; }
+        friend Float2 operator*(Float2 a, Float2 b) { return { a.l * b.l, a.r * b.r }; }
+
+        // Masks are 1.0f (true) / 0.0f (false) lanes
+        friend Float2 abs(Float2 a)                  { return { std::abs(a.l), std::abs(a.r) }; }
+        friend Float2 min(Float2 a, Float2 b)        { return { std::min(a.l, b.l), std::min(a.r, b.r) }; }
+        friend Float2 max(Float2 a, Float2 b)        { return { std::max(a.l, b.l), std::max(a.r, b.r) }; }
+        friend Float2 lessThan(Float2 a, Float2 b)   { return { a.l < b.l ? 1.0f : 0.0f, a.r < b.r ? 1.0f : 0.0f }; }
+        friend Float2 select(Float2 mask, Float2 ifTrue, Float2 ifFalse)
+        {
+            return { mask.l != 0.0f ? ifTrue.l : ifFalse.l, mask.r != 0.0f ? ifTrue.r : ifFalse.r };
+        }
+    };
+
+    struct Float4
+    {
+        float v[4];
+
+        template <typename Fn>
+        static Float4 map(Float4 a, Float4 b, Fn&& fn)
+        {
+            return { { fn(a.v[0], b.v[0]), fn(a.v[1], b.v[1]), fn(a.v[2], b.v[2]), fn(a.v[3], b.v[3]) } };
+        }
+
+        static Float4 broadcast(float x)           { return { { x, x, x, x } }; }
+        static Float4 load(const float* p)         { return { { p[0], p[1], p[2], p[3] } }; }
+        static Float4 fromValues(float a, float b, float c, float d) { return { { a, b, c, d } }; }
+        void store(float* p) const                 { std::memcpy(p, v, sizeof(v)); }
+
+        friend Float4 operator+(Float4 a, Float4 b) { return map(a, b, [](float x, float y) { return x + y; }); }
+        friend Float4 operator-(Float4 a, Float4 b) { return map(a, b, [](float x, float y) { return x - y; }); }
+        friend Float4 operator*(Float4 a, Float4 b) { return map(a, b, [](float x, float y) { return x * y; }); }
+        friend Float4 operator/(Float4 a, Float4 b) { return map(a, b, [](float x, float y) { return x / y; }); }
+
+        friend Float4 min(Float4 a, Float4 b)        { return map(a, b, [](float x, float y) { return std::min(x, y); }); }
+        friend Float4 max(Float4 a, Float4 b)        { return map(a, b, [](float x, float y) { return std::max(x, y); }); }
+        friend Float4 lessThan(Float4 a, Float4 b)   { return map(a, b, [](float x, float y) { return x < y ? 1.0f : 0.0f; }); }
+        friend Float4 select(Float4 mask, Float4 ifTrue, Float4 ifFalse)
+        {
+            Float4 r;
+            for (int i = 0; i < 4; ++i)
+                r.v[i] = mask.v[i] != 0.0f ? ifTrue.v[i] : ifFalse.v[i];
+            return r;
+        }
+
+        float horizontalSum() const { return (v[0] + v[1]) + (v[2] + v[3]); }
+        float horizontalMin() const { return std::min(std::min(v[0], v[1]), std::min(v[2], v[3])); }
+        float horizontalMax() const { return std::max(std::max(v[0], v[1]), std::max(v[2], v[3])); }
+
+        // Unbiased exponent of a positive normal float, as a float
+        static Float4 exponent(Float4 x)
+        {
+            Float4 r;
+            for (int i = 0; i < 4; ++i)
+            {
+                int32_t bits;
+                std::memcpy(&bits, &x.v[i], sizeof(bits));
+                r.v[i] = static_cast<float>(((bits >> 23) & 255) - 127);
+            }
+            return r;
+        }
+
+        // Mantissa of a positive normal float, in [1, 2)
+        static Float4 mantissa(Float4 x)
+        {
+            Float4 r;
+            for (int i = 0; i < 4; ++i)
+            {
+                int32_t bits;
+                std::memcpy(&bits, &x.v[i], sizeof(bits));
+                bits = (bits & 0x007FFFFF) | 0x3F800000;
+                std::memcpy(&r.v[i], &bits, sizeof(bits));
+            }
+            return r;
+        }
+
+        // floor() for |x| < 2^31
+        static Float4 floor(Float4 x)
+        {
+            Float4 r;
+            for (int i = 0; i < 4; ++i)
+                r.v[i] = std::floor(x.v[i]);
+            return r;
+        }
+
+        // x * 2^n for integral n, by adding n to the exponent bits (no overflow checks)
+        static Float4 scaleByPowerOfTwo(Float4 x, Float4 n)
+        {
+            Float4 r;
+            for (int i = 0; i < 4; ++i)
+            {
+                int32_t bits;
+                std::memcpy(&bits, &x.v[i], sizeof(bits));
+                bits += static_cast<int32_t>(n.v[i]) * (1 << 23);
+                std::memcpy(&r.v[i], &bits, sizeof(bits));
+            }
+            return r;
+        }
+    };
+#endif
+}
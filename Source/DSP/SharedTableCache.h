@@ -0,0 +1,45 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+
+/**
+ * Per-sample-rate cache of read-only tables shared across instances
+ *
+ * The first instance prepared at a given rate builds the table; every
+ * other instance at that rate gets the same copy. Tables are released
+ * when the last instance holding them goes away.
+ *
+ * get() locks and may allocate - call from prepare(), never from process().
+ */
+template <typename Table>
+class SharedTableCache
+{
+public:
+    template <typename Builder>
+    static std::shared_ptr<const Table> get(double sampleRate, Builder&& build)
+    {
+        static std::mutex lock;
+        static std::vector<std::pair<double, std::weak_ptr<const Table>>> tables;
+
+        std::lock_guard<std::mutex> guard(lock);
+
+        // Drop entries whose instances have all gone
+        tables.erase(std::remove_if(tables.begin(), tables.end(),
+                                    [](const auto& entry) { return entry.second.expired(); }),
+                     tables.end());
+
+        for (auto& entry : tables)
+            if (entry.first == sampleRate)
+                if (auto table = entry.second.lock())
+                    return table;
+
+        auto table = std::make_shared<Table>();
+        build(*table, sampleRate);
+
+        tables.emplace_back(sampleRate, table);
+        return table;
+    }
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <atomic>
+
+/**
+ * Lock-free hand-off of immutable settings snapshots (triple buffer)
+ *
+ * A non-realtime writer fills a snapshot and publishes it; the audio
+ * thread pulls the newest one at the start of a block. Publishing swaps
+ * slot indices atomically, and a slot only becomes writable again once
+ * the reader has moved off it, so reclamation is deferred without any
+ * allocation, locking or waiting on either side.
+ *
+ * - publish(): one writer thread at a time
+ * - pull()/current(): the audio thread only
+ */
+template <typename T>
+class SnapshotExchange
+{
+public:
+    // Writer: copy a complete snapshot into the back slot and make it visible
+    void publish(const T& snapshot)
+    {
+        slots[back] = snapshot;
+        back = middle.exchange(back | freshFlag, std::memory_order_acq_rel) & indexMask;
+    }
+
+    // Reader: adopt the newest snapshot if one was published; true if it changed
+    bool pull()
+    {
+        if ((middle.load(std::memory_order_relaxed) & freshFlag) == 0)
+            return false;
+
+        front = middle.exchange(front, std::memory_order_acq_rel) & indexMask;
+        return true;
+    }
+
+    // Reader: the snapshot adopted by the last pull()
+    const T& current() const { return slots[front]; }
+
+private:
+    static constexpr int indexMask = 3;
+    static constexpr int freshFlag = 4;
+
+    T slots[3] {};
+    int front = 0;                      // owned by the reader
+    int back = 1;                       // owned by the writer
+    std::atomic<int> middle { 2 };      // shared: slot index + fresh flag
+};
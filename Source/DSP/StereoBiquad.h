@@ -0,0 +1,84 @@
+#pragma once
+
+#include "SIMDTypes.h"
+
+// Normalised biquad coefficients (a0 = 1)
+struct BiquadCoefficients
+{
+    float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f;
+    float a1 = 0.0f, a2 = 0.0f;
+};
+
+/**
+ * Stereo Biquad (Direct Form I)
+ *
+ * Runs left and right as the two lanes of one SIMD register, so a
+ * stereo block costs a single pass through the recursion instead of
+ * one per channel. State is kept interleaved (x1 = {x1L, x1R}, ...).
+ *
+ * Mono buffers are processed in the left lane; the right lane just
+ * shadows it and its output is discarded.
+ */
+class StereoBiquad
+{
+public:
+    void setCoefficients(float b0, float b1, float b2, float a1, float a2)
+    {
+        cb0 = SIMD::Float2::broadcast(b0);
+        cb1 = SIMD::Float2::broadcast(b1);
+        cb2 = SIMD::Float2::broadcast(b2);
+        ca1 = SIMD::Float2::broadcast(a1);
+        ca2 = SIMD::Float2::broadcast(a2);
+    }
+
+    void setCoefficients(const BiquadCoefficients& c)
+    {
+        setCoefficients(c.b0, c.b1, c.b2, c.a1, c.a2);
+    }
+
+    void setUnity() { setCoefficients(1.0f, 0.0f, 0.0f, 0.0f, 0.0f); }
+
+    void reset()
+    {
+        x1 = x2 = y1 = y2 = SIMD::Float2::broadcast(0.0f);
+    }
+
+    inline SIMD::Float2 processSample(SIMD::Float2 x0)
+    {
+        SIMD::Float2 y0 = cb0 * x0 + cb1 * x1 + cb2 * x2 - ca1 * y1 - ca2 * y2;
+
+        x2 = x1;
+        x1 = x0;
+        y2 = y1;
+        y1 = y0;
+
+        return y0;
+    }
+
+    // Process in place; right may be nullptr for mono
+    void process(float* left, float* right, int numSamples)
+    {
+        if (right == nullptr)
+        {
+            for (int i = 0; i < numSamples; ++i)
+                left[i] = processSample(SIMD::Float2::broadcast(left[i])).left();
+            return;
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+            processSample(SIMD::Float2::load(left + i, right + i)).store(left + i, right + i);
+    }
+
+private:
+    SIMD::Float2 cb0 = SIMD::Float2::broadcast(1.0f);
+    SIMD::Float2 cb1 = SIMD::Float2::broadcast(0.0f);
+    SIMD::Float2 cb2 = SIMD::Float2::broadcast(0.0f);
+    SIMD::Float2 ca1 = SIMD::Float2::broadcast(0.0f);
+    SIMD::Float2 ca2 = SIMD::Float2::broadcast(0.0f);
+
+    // Interleaved L/R state
+    SIMD::Float2 x1 = SIMD::Float2::broadcast(0.0f);
+    SIMD::Float2 x2 = SIMD::Float2::broadcast(0.0f);
+    SIMD::Float2 y1 = SIMD::Float2::broadcast(0.0f);
+    SIMD::Float2 y2 = SIMD::Float2::broadcast(0.0f);
+};
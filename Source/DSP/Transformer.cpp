@@ -3,6 +3,7 @@
 
 Transformer::Transformer()
 {
+    updateShaper();
 }
 
 void Transformer::prepare(double sampleRate, int /*samplesPerBlock*/)
@@ -14,26 +15,35 @@ void Transformer::prepare(double sampleRate, int /*samplesPerBlock*/)
 
 void Transformer::reset()
 {
-    lpStateL = 0.0f;
-    lpStateR = 0.0f;
-    hpStateL = 0.0f;
-    hpStateR = 0.0f;
-    dcBlockStateL = 0.0f;
-    dcBlockStateR = 0.0f;
+    for (auto& state : channelState)
+    {
+        state.lpState = 0.0f;
+        state.hpState = 0.0f;
+        state.dcBlockState = 0.0f;
+        state.saturator.reset();
+    }
+
+    oversampler.reset();
 }
 
 void Transformer::updateCoefficients()
 {
-    // Low-frequency coloration around 100Hz
-    float lpFreq = 100.0f;
-    lpCoeff = 1.0f - std::exp(-2.0f * 3.14159265359f * lpFreq / static_cast<float>(currentSampleRate));
+    for (int stages = 0; stages <= Oversampler::maxStages; ++stages)
+    {
+        const float rate = static_cast<float>(currentSampleRate) * static_cast<float>(1 << stages);
+        RateCoefficients& c = rateCoefficients[stages];
+
+        // Low-frequency coloration around 100Hz
+        float lpFreq = 100.0f;
+        c.lpCoeff = 1.0f - std::exp(-2.0f * 3.14159265359f * lpFreq / rate);
 
-    // High-frequency "silk" around 8kHz
-    float hpFreq = 8000.0f;
-    hpCoeff = std::exp(-2.0f * 3.14159265359f * hpFreq / static_cast<float>(currentSampleRate));
+        // High-frequency "silk" around 8kHz
+        float hpFreq = 8000.0f;
+        c.hpCoeff = std::exp(-2.0f * 3.14159265359f * hpFreq / rate);
 
-    // DC blocking coefficient (very slow filter to remove DC)
-    dcBlockCoeff = 1.0f - (20.0f / static_cast<float>(currentSampleRate));
+        // DC blocking coefficient (very slow filter to remove DC)
+        c.dcBlockCoeff = 1.0f - (20.0f / rate);
+    }
 }
 
 void Transformer::setDrive(float drivePercent)
@@ -41,9 +51,28 @@ void Transformer::setDrive(float drivePercent)
     drive = std::clamp(drivePercent / 100.0f, 0.0f, 1.0f);
     // Map drive 0-1 to gain 1-4 for saturation
     driveGain = 1.0f + drive * 3.0f;
+    updateShaper();
+}
+
+void Transformer::setQuality(Quality newQuality)
+{
+    quality = newQuality;
+    updateShaper();
+}
+
+void Transformer::updateShaper()
+{
+    pendingShaper.drive = drive;
+    pendingShaper.driveGain = driveGain;
+    pendingShaper.quality = quality;
+
+    if (quality != QUALITY_ANALYTIC)
+        buildShaper(pendingShaper);
+
+    shaper.publish(pendingShaper);
 }
 
-float Transformer::processSample(float input)
+float Transformer::processSample(float input, float drive, float driveGain)
 {
     if (drive < 0.001f)
         return input;
@@ -76,70 +105,282 @@ float Transformer::processSample(float input)
     return input * (1.0f - drive * 0.7f) + output * drive * 0.7f + output * 0.3f;
 }
 
-void Transformer::process(juce::AudioBuffer<float>& buffer)
+void Transformer::buildShaper(Shaper& s)
 {
-    const int numChannels = buffer.getNumChannels();
-    const int numSamples = buffer.getNumSamples();
+    // processSample() in double, as dry * u + wet * tanh(k b(u)) with
+    // b(u) = g u + a (g u)^2 and k picked by the sign of b
+    const double d = s.drive;
+    const double g = s.driveGain;
+    const double a = 0.15 * d;
+    const double dry = 1.0 - d * 0.7;
+    const double wet = (d * 0.7 + 0.3) / g;
+
+    auto biased = [g, a](double u) { return g * u + a * g * g * u * u; };
+    auto slopeFor = [d](double b) { return b >= 0.0 ? 1.0 + d : 1.0 + d * 0.8; };
+
+    // The curve kinks where b crosses zero: at u = 0, which is a breakpoint,
+    // and at u = -1 / (a g), which generally isn't. Each segment takes k from
+    // its midpoint and evaluates its own end slopes; the one segment holding
+    // the second kink can't follow it and is left to the analytic curve.
+    auto value = [&](double u, double k) { return dry * u + wet * std::tanh(k * biased(u)); };
+    auto derivative = [&](double u, double k)
+    {
+        const double t = std::tanh(k * biased(u));
+        return dry + wet * k * (1.0 - t * t) * (g + 2.0 * a * g * g * u);
+    };
+
+    const double h = 2.0 * Shaper::tableRange / Shaper::tableSize;
+
+    s.kinkSegment = -1;
+    if (a > 0.0)
+    {
+        const double kink = (-1.0 / (a * g) + Shaper::tableRange) / h;
+        if (kink >= 0.0)
+            s.kinkSegment = static_cast<int>(kink);
+    }
+
+    for (int i = 0; i < Shaper::tableSize; ++i)
+    {
+        const double u0 = -Shaper::tableRange + i * h;
+        const double u1 = u0 + h;
+        const double k = slopeFor(biased(u0 + 0.5 * h));
 
-    if (numChannels == 0 || drive < 0.001f)
+        // The breakpoint itself takes its own k: the linear quality reads it
+        // as the previous segment's end, even next to the second kink
+        const double y0 = value(u0, slopeFor(biased(u0)));
+        const double y1 = value(u1, k);
+        const double m0 = derivative(u0, k) * h;
+        const double m1 = derivative(u1, k) * h;
+
+        // Cubic Hermite through both ends with the analytic slopes
+        s.table[i][0] = static_cast<float>(y0);
+        s.table[i][1] = static_cast<float>(m0);
+        s.table[i][2] = static_cast<float>(3.0 * (y1 - y0) - 2.0 * m0 - m1);
+        s.table[i][3] = static_cast<float>(2.0 * (y0 - y1) + m0 + m1);
+    }
+
+    const double end = Shaper::tableRange;
+    s.table[Shaper::tableSize][0] = static_cast<float>(value(end, slopeFor(biased(end))));
+}
+
+void Transformer::shapeBlock(const float* input, float* output, int numSamples, const Shaper& s)
+{
+    using SIMD::Float4;
+
+    if (s.quality == QUALITY_ANALYTIC)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            output[i] = processSample(input[i], s.drive, s.driveGain);
         return;
+    }
+
+    // Four samples at a time: position and interpolation in Float4, the
+    // table rows fetched per lane. Callers pad the input to a multiple of 4.
+    const Float4 offset = Float4::broadcast(Shaper::tableRange);
+    const Float4 scale = Float4::broadcast(Shaper::tableSize / (2.0f * Shaper::tableRange));
+    const Float4 lowest = Float4::broadcast(0.0f);
+    const Float4 highest = Float4::broadcast(static_cast<float>(Shaper::tableSize) - 0.001f);
+    const bool cubic = s.quality == QUALITY_CUBIC;
+
+    alignas(16) float index[4];
+
+    for (int i = 0; i < numSamples; i += 4)
+    {
+        const Float4 position = min(max((Float4::load(input + i) + offset) * scale, lowest), highest);
+        const Float4 whole = Float4::floor(position);
+        const Float4 t = position - whole;
+        whole.store(index);
+
+        const int i0 = static_cast<int>(index[0]);
+        const int i1 = static_cast<int>(index[1]);
+        const int i2 = static_cast<int>(index[2]);
+        const int i3 = static_cast<int>(index[3]);
+        const float* r0 = s.table[i0];
+        const float* r1 = s.table[i1];
+        const float* r2 = s.table[i2];
+        const float* r3 = s.table[i3];
+
+        Float4 y;
+        if (cubic)
+        {
+            const Float4 c0 = Float4::fromValues(r0[0], r1[0], r2[0], r3[0]);
+            const Float4 c1 = Float4::fromValues(r0[1], r1[1], r2[1], r3[1]);
+            const Float4 c2 = Float4::fromValues(r0[2], r1[2], r2[2], r3[2]);
+            const Float4 c3 = Float4::fromValues(r0[3], r1[3], r2[3], r3[3]);
+            y = c0 + t * (c1 + t * (c2 + t * c3));
+        }
+        else
+        {
+            const Float4 y0 = Float4::fromValues(r0[0], r1[0], r2[0], r3[0]);
+            const Float4 y1 = Float4::fromValues(s.table[i0 + 1][0], s.table[i1 + 1][0],
+                                                 s.table[i2 + 1][0], s.table[i3 + 1][0]);
+            y = y0 + t * (y1 - y0);
+        }
+
+        y.store(output + i);
+
+        // Rare: inputs past the table (> +12 dBFS into the shaper) or in the
+        // segment around the second kink
+        for (int lane = 0; lane < 4; ++lane)
+        {
+            if (std::abs(input[i + lane]) > Shaper::tableRange || static_cast<int>(index[lane]) == s.kinkSegment)
+                output[i + lane] = processSample(input[i + lane], s.drive, s.driveGain);
+        }
+    }
+}
+
+void Transformer::processChannel(float* data, int numSamples, ChannelState& state, const RateCoefficients& c,
+                                 const Shaper& s)
+{
+    const float shaperDrive = s.drive;
+
+    alignas(16) float shaperInput[chunkSize];
+    alignas(16) float shaped[chunkSize];
+    float silk[chunkSize];
+
+    for (int start = 0; start < numSamples; start += chunkSize)
+    {
+        const int n = std::min(chunkSize, numSamples - start);
+        float* block = data + start;
+
+        // Pass 1: the recursive filters feeding the shaper
+        for (int i = 0; i < n; ++i)
+        {
+            float sample = block[i];
+
+            // Low-frequency enhancement (transformer "weight")
+            float lowFreq = state.lpState + c.lpCoeff * (sample - state.lpState);
+            state.lpState = lowFreq;
+            float lowEnhance = (lowFreq - sample) * shaperDrive * 0.3f;
+
+            // High-frequency "silk" (subtle presence boost)
+            float highFreq = sample - state.hpState;
+            state.hpState = state.hpState + (1.0f - c.hpCoeff) * highFreq;
+            silk[i] = highFreq * shaperDrive * 0.15f;
+
+            shaperInput[i] = sample + lowEnhance;
+        }
+
+        const int padded = (n + 3) & ~3;
+        for (int i = n; i < padded; ++i)
+            shaperInput[i] = 0.0f;
+
+        // Pass 2: saturation, no recurrence
+        shapeBlock(shaperInput, shaped, padded, s);
+
+        // Pass 3: add high-frequency silk, DC blocking
+        for (int i = 0; i < n; ++i)
+        {
+            float processed = shaped[i] + silk[i];
+
+            float dcBlocked = processed - state.dcBlockState;
+            state.dcBlockState = processed - dcBlocked * c.dcBlockCoeff;
+
+            block[i] = dcBlocked;
+        }
+    }
+}
+
+void Transformer::processChannelADAA(float* data, int numSamples, ChannelState& state, const RateCoefficients& c,
+                                     const Shaper& s)
+{
+    const float shaperDrive = s.drive;
+    const float shaperGain = s.driveGain;
+
+    // processSample() split into its tanh term, which goes through ADAA,
+    // and the linear terms, which are delayed to match
+    const float asymmetry = 0.15f * shaperDrive;
+    const float dryGain = 1.0f - shaperDrive * 0.7f;
+    const float wetGain = (shaperDrive * 0.7f + 0.3f) / shaperGain;
+
+    ADAATanh& saturator = state.saturator;
+    saturator.setSlopes(1.0 + shaperDrive, 1.0 + shaperDrive * 0.8);
 
-    // Process left channel
-    float* left = buffer.getWritePointer(0);
     for (int i = 0; i < numSamples; ++i)
     {
-        float sample = left[i];
+        float sample = data[i];
 
         // Low-frequency enhancement (transformer "weight")
-        float lowFreq = lpStateL + lpCoeff * (sample - lpStateL);
-        lpStateL = lowFreq;
-        float lowEnhance = (lowFreq - sample) * drive * 0.3f;
+        float lowFreq = state.lpState + c.lpCoeff * (sample - state.lpState);
+        state.lpState = lowFreq;
+        float lowEnhance = (lowFreq - sample) * shaperDrive * 0.3f;
 
         // High-frequency "silk" (subtle presence boost)
-        float highFreq = sample - hpStateL;
-        hpStateL = hpStateL + (1.0f - hpCoeff) * highFreq;
-        float highEnhance = highFreq * drive * 0.15f;
+        float highFreq = sample - state.hpState;
+        state.hpState = state.hpState + (1.0f - c.hpCoeff) * highFreq;
+        float highEnhance = highFreq * shaperDrive * 0.15f;
 
-        // Apply saturation
-        float processed = processSample(sample + lowEnhance);
+        // Asymmetric saturation
+        float input = sample + lowEnhance;
+        float driven = input * shaperGain;
+        float biased = driven + asymmetry * driven * driven;
 
-        // Add high-frequency silk
-        processed += highEnhance;
+        float processed = saturator.process(biased) * wetGain
+                        + saturator.alignLinear(input * dryGain + highEnhance);
 
         // DC blocking
-        float dcBlocked = processed - dcBlockStateL;
-        dcBlockStateL = processed - dcBlocked * dcBlockCoeff;
+        float dcBlocked = processed - state.dcBlockState;
+        state.dcBlockState = processed - dcBlocked * c.dcBlockCoeff;
 
-        left[i] = dcBlocked;
+        data[i] = dcBlocked;
     }
+}
+
+void Transformer::process(AudioSpan buffer)
+{
+    const int numChannels = std::min(buffer.getNumChannels(), 2);
+    const int numSamples = buffer.getNumSamples();
+
+    if (numChannels == 0)
+        return;
+
+    shaper.pull();
+    const Shaper& s = shaper.current();
+
+    const int stages = oversampler.beginBlock();
+    const bool active = s.drive >= 0.001f;
 
-    // Process right channel if stereo
-    if (numChannels > 1)
+    const auto antiAliasing = static_cast<ADAATanh::Order>(requestedAntiAliasing.load(std::memory_order_relaxed));
+    for (auto& state : channelState)
+        state.saturator.setOrder(antiAliasing);
+
+    auto processChannelAtRate = [this, antiAliasing, &s](float* data, int n, ChannelState& state,
+                                                         const RateCoefficients& c)
     {
-        float* right = buffer.getWritePointer(1);
-        for (int i = 0; i < numSamples; ++i)
-        {
-            float sample = right[i];
+        if (antiAliasing == ADAATanh::ORDER_NONE)
+            processChannel(data, n, state, c, s);
+        else
+            processChannelADAA(data, n, state, c, s);
+    };
 
-            // Low-frequency enhancement
-            float lowFreq = lpStateR + lpCoeff * (sample - lpStateR);
-            lpStateR = lowFreq;
-            float lowEnhance = (lowFreq - sample) * drive * 0.3f;
+    if (stages == 0)
+    {
+        if (!active)
+            return;
 
-            // High-frequency "silk"
-            float highFreq = sample - hpStateR;
-            hpStateR = hpStateR + (1.0f - hpCoeff) * highFreq;
-            float highEnhance = highFreq * drive * 0.15f;
+        for (int ch = 0; ch < numChannels; ++ch)
+            processChannelAtRate(buffer.getWritePointer(ch), numSamples, channelState[ch], rateCoefficients[0]);
+        return;
+    }
 
-            // Apply saturation
-            float processed = processSample(sample + lowEnhance);
-            processed += highEnhance;
+    // Oversampled: the resampling filters keep running at zero drive so the
+    // reported latency holds whatever the setting
+    float* left = buffer.getWritePointer(0);
+    float* right = numChannels > 1 ? buffer.getWritePointer(1) : nullptr;
+
+    for (int start = 0; start < numSamples; start += Oversampler::maxBlockSize)
+    {
+        const int n = std::min(Oversampler::maxBlockSize, numSamples - start);
 
-            // DC blocking
-            float dcBlocked = processed - dcBlockStateR;
-            dcBlockStateR = processed - dcBlocked * dcBlockCoeff;
+        oversampler.upsample(left + start, right != nullptr ? right + start : nullptr, n);
 
-            right[i] = dcBlocked;
+        if (active)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+                processChannelAtRate(oversampler.getOversampledChannel(ch), n << stages, channelState[ch],
+                                     rateCoefficients[stages]);
         }
+
+        oversampler.downsample(left + start, right != nullptr ? right + start : nullptr, n);
     }
 }
@@ -1,6 +1,9 @@
 #pragma once
 
-#include <JuceHeader.h>
+#include "AudioSpan.h"
+#include "Oversampler.h"
+#include "ADAATanh.h"
+#include "SnapshotExchange.h"
 
 /**
  * Neve-style Transformer Saturation
@@ -10,6 +13,16 @@
  * - Low-frequency "weight" from core saturation
  * - High-frequency "silk" from transformer resonance
  * - Subtle low-frequency phase shift
+ * - Optional 2x/4x/8x oversampling around the whole chain, so the
+ *   saturator's harmonics don't fold back into the audio band
+ * - Optional 1st-order ADAA of the tanh curves: most of the alias
+ *   suppression of 2x oversampling at about the cost of plain tanh,
+ *   adding half a sample of delay at the processing rate
+ * - The saturation curve is read from a linear or cubic table by default;
+ *   drive changes rebuild it off the audio thread
+ *
+ * Threading: setDrive() and setQuality() run on one non-realtime thread
+ * and publish a Shaper snapshot; process() adopts the newest one per block.
  */
 class Transformer
 {
@@ -17,37 +30,93 @@ public:
     Transformer();
 
     void prepare(double sampleRate, int samplesPerBlock);
-    void process(juce::AudioBuffer<float>& buffer);
+    void process(AudioSpan buffer);
     void reset();
 
+    // Waveshaper evaluation
+    enum Quality { QUALITY_ANALYTIC = 0, QUALITY_LINEAR, QUALITY_CUBIC };
+
     // Drive amount (0-100%)
     void setDrive(float drivePercent);
+    void setQuality(Quality newQuality);
+
+    // Oversampling: 0-3 stages (1x-8x), any thread
+    void setOversampling(int numStages, Oversampler::Mode mode) { oversampler.setConfiguration(numStages, mode); }
+
+    // Antiderivative anti-aliasing order, any thread
+    void setAntiAliasing(ADAATanh::Order order) { requestedAntiAliasing.store(order, std::memory_order_relaxed); }
+
+    // Everything process() derives from drive, built off the audio thread
+    struct Shaper
+    {
+        static constexpr int tableSize = 1024;          // Segments
+        static constexpr float tableRange = 4.0f;       // Inputs within +/- tableRange use the table
+
+        float drive = 0.0f;          // 0-1 range
+        float driveGain = 1.0f;      // Linear gain from drive
+        Quality quality = QUALITY_CUBIC;
+
+        // Segment holding the curve's second kink (where the bias returns to
+        // zero), evaluated analytically; -1 when it lies off the table
+        int kinkSegment = -1;
+
+        // Segment i covers [-range + i h, -range + (i + 1) h) as
+        // c0 + t (c1 + t (c2 + t c3)), t in [0, 1). The c0 column alone is
+        // the curve sampled at the breakpoints (linear quality).
+        alignas(16) float table[tableSize + 1][4] {};
+    };
 
 private:
-    float processSample(float input);
+    // Filter coefficients for one processing rate
+    struct RateCoefficients
+    {
+        float lpCoeff = 0.0f;
+        float hpCoeff = 0.0f;
+        float dcBlockCoeff = 0.995f;
+    };
+
+    // Per-channel filter state
+    struct ChannelState
+    {
+        float lpState = 0.0f;
+        float hpState = 0.0f;
+        float dcBlockState = 0.0f;
+        ADAATanh saturator;
+    };
+
+    static constexpr int chunkSize = 256;
+
+    static float processSample(float input, float drive, float driveGain);
+    static void buildShaper(Shaper& shaper);
+
+    // The saturation curve over a block, analytic or interpolated
+    static void shapeBlock(const float* input, float* output, int numSamples, const Shaper& s);
+
+    void processChannel(float* data, int numSamples, ChannelState& state, const RateCoefficients& c,
+                        const Shaper& s);
+    void processChannelADAA(float* data, int numSamples, ChannelState& state, const RateCoefficients& c,
+                            const Shaper& s);
     void updateCoefficients();
+    void updateShaper();
 
     // Parameters
     float drive = 0.0f;          // 0-1 range
     float driveGain = 1.0f;      // Linear gain from drive
+    Quality quality = QUALITY_CUBIC;
 
-    // State for low-frequency coloration (one-pole filter)
-    float lpStateL = 0.0f;
-    float lpStateR = 0.0f;
+    // Built by the setters, then published to the audio thread
+    Shaper pendingShaper;
+    SnapshotExchange<Shaper> shaper;
 
-    // State for high-frequency "silk" (subtle resonance)
-    float hpStateL = 0.0f;
-    float hpStateR = 0.0f;
+    // Low-frequency coloration, high-frequency "silk" and DC blocking state
+    ChannelState channelState[2];
 
-    // Filter coefficients
-    float lpCoeff = 0.0f;
-    float hpCoeff = 0.0f;
+    // Filter coefficients at 1x, 2x, 4x and 8x the host rate
+    RateCoefficients rateCoefficients[Oversampler::maxStages + 1];
 
     // Sample rate
     double currentSampleRate = 44100.0;
 
-    // DC blocking filter state
-    float dcBlockStateL = 0.0f;
-    float dcBlockStateR = 0.0f;
-    float dcBlockCoeff = 0.995f;
+    Oversampler oversampler;
+    std::atomic<int> requestedAntiAliasing { ADAATanh::ORDER_NONE };
 };
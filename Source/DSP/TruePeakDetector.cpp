@@ -0,0 +1,206 @@
+#include "TruePeakDetector.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // Coefficients for window[j] (oldest first), one lane per phase
+    struct InterpolatorTaps
+    {
+        SIMD::Float4 taps[TruePeakDetector::tapsPerPhase];
+
+        // Block passes put consecutive outputs in the lanes instead. The
+        // filter is linear phase, so phase 3 - q is phase q reversed:
+        // phase q = S + D and phase 3 - q = S - D, with S the half-sum taps on
+        // v[w] + v[11 - w] and D the half-difference taps on v[w] - v[11 - w].
+        // Per window position w < 6, broadcast: {S0, D0, S1, D1}
+        static constexpr int foldedTaps = TruePeakDetector::tapsPerPhase / 2;
+        SIMD::Float4 folded[foldedTaps][4];
+
+        InterpolatorTaps()
+        {
+            constexpr int length = TruePeakDetector::numPhases * TruePeakDetector::tapsPerPhase;
+            constexpr double pi = 3.14159265358979323846;
+            constexpr double centre = 0.5 * (length - 1);
+            constexpr double beta = 7.0;
+
+            auto besselI0 = [](double x)
+            {
+                double sum = 1.0, term = 1.0;
+                for (int k = 1; k < 40; ++k)
+                {
+                    term *= (x / (2.0 * k)) * (x / (2.0 * k));
+                    sum += term;
+                }
+                return sum;
+            };
+
+            double h[length];
+            for (int k = 0; k < length; ++k)
+            {
+                const double t = (k - centre) / TruePeakDetector::numPhases;
+                const double r = (k - centre) / (centre + 1.0);
+                const double sinc = std::sin(pi * t) / (pi * t);     // t is never 0 (even length)
+                h[k] = sinc * besselI0(beta * std::sqrt(1.0 - r * r)) / besselI0(beta);
+            }
+
+            // Phase q reconstructs the waveform (centre - q) / 4 samples back,
+            // from taps h[4j + q] applied to input[n - j]; unity gain per phase
+            float lanes[TruePeakDetector::numPhases][TruePeakDetector::tapsPerPhase];
+            for (int q = 0; q < TruePeakDetector::numPhases; ++q)
+            {
+                double sum = 0.0;
+                for (int j = 0; j < TruePeakDetector::tapsPerPhase; ++j)
+                    sum += h[TruePeakDetector::numPhases * j + q];
+
+                for (int j = 0; j < TruePeakDetector::tapsPerPhase; ++j)
+                    lanes[q][TruePeakDetector::tapsPerPhase - 1 - j]
+                        = static_cast<float>(h[TruePeakDetector::numPhases * j + q] / sum);
+            }
+
+            for (int w = 0; w < TruePeakDetector::tapsPerPhase; ++w)
+                taps[w] = SIMD::Float4::fromValues(lanes[0][w], lanes[1][w], lanes[2][w], lanes[3][w]);
+
+            for (int w = 0; w < foldedTaps; ++w)
+            {
+                const int mirror = TruePeakDetector::tapsPerPhase - 1 - w;
+
+                for (int q = 0; q < 2; ++q)
+                {
+                    folded[w][2 * q] = SIMD::Float4::broadcast(0.5f * (lanes[q][w] + lanes[q][mirror]));
+                    folded[w][2 * q + 1] = SIMD::Float4::broadcast(0.5f * (lanes[q][w] - lanes[q][mirror]));
+                }
+            }
+        }
+    };
+
+    const InterpolatorTaps& getTaps()
+    {
+        static const InterpolatorTaps taps;
+        return taps;
+    }
+}
+
+TruePeakDetector::TruePeakDetector()
+{
+    getTaps();
+}
+
+void TruePeakDetector::reset()
+{
+    for (auto& sample : history)
+        sample = 0.0f;
+
+    position = 0;
+    previousSegmentPeak = 0.0f;
+}
+
+inline float TruePeakDetector::processSample(float input)
+{
+    using SIMD::Float4;
+
+    history[position] = input;
+    history[position + tapsPerPhase] = input;
+    position = position + 1 == tapsPerPhase ? 0 : position + 1;
+
+    const float* window = history + position;     // Oldest first
+    const Float4* taps = getTaps().taps;
+
+    Float4 sum = taps[0] * Float4::broadcast(window[0]);
+    for (int j = 1; j < tapsPerPhase; ++j)
+        sum = sum + taps[j] * Float4::broadcast(window[j]);
+
+    // The four interpolated points between input[n - 6] and input[n - 5]
+    // (inclusive of both samples)
+    const Float4 magnitude = max(sum, Float4::broadcast(0.0f) - sum);
+    const float segmentPeak = std::max(magnitude.horizontalMax(),
+                                       std::max(std::abs(window[tapsPerPhase - 1 - latencySamples]),
+                                                std::abs(window[tapsPerPhase - latencySamples])));
+
+    // Both segments touching input[n - 6]
+    const float peak = std::max(segmentPeak, previousSegmentPeak);
+    previousSegmentPeak = segmentPeak;
+    return peak;
+}
+
+void TruePeakDetector::process(const float* input, float* peaks, int numSamples)
+{
+    for (int i = 0; i < numSamples; ++i)
+        peaks[i] = processSample(input[i]);
+}
+
+float TruePeakDetector::processBlockPeak(const float* input, int numSamples)
+{
+    using SIMD::Float4;
+
+    constexpr int window = tapsPerPhase;
+    const InterpolatorTaps& t = getTaps();
+
+    // Linear copy: the newest window samples (oldest first), then the chunk
+    alignas(16) float x[window + blockChunkSize + 4];
+    for (int j = 0; j < window; ++j)
+        x[j] = history[position + j];
+
+    const Float4 zero = Float4::broadcast(0.0f);
+    const Float4 laneIndex = Float4::fromValues(0.0f, 1.0f, 2.0f, 3.0f);
+    Float4 peak = Float4::broadcast(previousSegmentPeak);
+    float lastSegmentPeak = previousSegmentPeak;
+
+    for (int start = 0; start < numSamples; start += blockChunkSize)
+    {
+        const int n = std::min(blockChunkSize, numSamples - start);
+        std::copy(input + start, input + start + n, x + window);
+        std::fill(x + window + n, x + window + n + 4, 0.0f);
+
+        // Output i sees x[i + 1 .. i + window]; four outputs per step
+        for (int i = 0; i < n; i += 4)
+        {
+            const float* v = x + i + 1;
+            Float4 s0 = zero, d0 = zero, s1 = zero, d1 = zero;
+
+            for (int w = 0; w < InterpolatorTaps::foldedTaps; ++w)
+            {
+                const Float4 newer = Float4::load(v + w);
+                const Float4 older = Float4::load(v + window - 1 - w);
+                const Float4 sum = newer + older;
+                const Float4 difference = newer - older;
+
+                s0 = s0 + t.folded[w][0] * sum;
+                d0 = d0 + t.folded[w][1] * difference;
+                s1 = s1 + t.folded[w][2] * sum;
+                d1 = d1 + t.folded[w][3] * difference;
+            }
+
+            // max(|S + D|, |S - D|) = |S| + |D| covers each mirrored pair of phases
+            Float4 m = max(max(s0, zero - s0) + max(d0, zero - d0),
+                           max(s1, zero - s1) + max(d1, zero - d1));
+
+            // The sample points either side of each segment
+            const Float4 before = Float4::load(x + i + window - latencySamples);
+            const Float4 after = Float4::load(x + i + window + 1 - latencySamples);
+            m = max(m, max(max(before, zero - before), max(after, zero - after)));
+
+            // Lanes past the end of the chunk read zero padding
+            m = select(lessThan(laneIndex, Float4::broadcast(static_cast<float>(n - i))), m, zero);
+            peak = max(peak, m);
+
+            if (i + 4 >= n)
+            {
+                alignas(16) float lanes[4];
+                m.store(lanes);
+                lastSegmentPeak = lanes[(n - 1 - i) & 3];
+            }
+        }
+
+        // Slide the window
+        std::copy(x + n, x + n + window, x);
+    }
+
+    // Hand the state back in the ring layout process() uses
+    for (int j = 0; j < window; ++j)
+        history[j] = history[j + window] = x[j];
+    position = 0;
+    previousSegmentPeak = lastSegmentPeak;
+
+    return peak.horizontalMax();
+}
@@ -0,0 +1,158 @@
+#include "DeadlineMonitor.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+template <typename T>
+static void increment(std::atomic<T>& counter, T amount = 1)
+{
+    // Single writer: a plain load/store pair, no locked read-modify-write
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+static int binFor(double load)
+{
+    if (load <= 0.0)
+        return 0;
+
+    const double octave = std::log2(load);
+    if (octave < DeadlineMonitor::minimumLoadOctave)
+        return 0;
+    if (octave >= DeadlineMonitor::maximumLoadOctave)
+        return DeadlineMonitor::numBins - 1;
+
+    const int bin = 1 + static_cast<int>((octave - DeadlineMonitor::minimumLoadOctave) * DeadlineMonitor::binsPerOctave);
+    return std::min(bin, DeadlineMonitor::numBins - 2);
+}
+
+void DeadlineMonitor::prepare(double sampleRate)
+{
+    nanosecondsPerSample.store(1.0e9 / std::max(sampleRate, 1.0), std::memory_order_relaxed);
+    requestReset();
+}
+
+void DeadlineMonitor::record(std::chrono::steady_clock::duration elapsed, int numSamples)
+{
+    if (numSamples <= 0)
+        return;
+
+    if (resetRequested.exchange(false, std::memory_order_relaxed))
+        clear();
+
+    const auto nanoseconds = static_cast<uint64_t>(std::max<int64_t>(
+        0, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    const double deadline = static_cast<double>(numSamples) * nanosecondsPerSample.load(std::memory_order_relaxed);
+    const double load = static_cast<double>(nanoseconds) / deadline;
+
+    increment(callbacks);
+    if (load > 0.5)
+        increment(over50);
+    if (load > 0.75)
+        increment(over75);
+    if (load > 0.9)
+        increment(over90);
+    if (load > 1.0)
+        increment(overruns);
+
+    increment(totalNanoseconds, nanoseconds);
+    increment(totalDeadlineNanoseconds, static_cast<uint64_t>(deadline));
+
+    if (load > worstLoad.load(std::memory_order_relaxed))
+        worstLoad.store(load, std::memory_order_relaxed);
+    if (nanoseconds > worstNanoseconds.load(std::memory_order_relaxed))
+        worstNanoseconds.store(nanoseconds, std::memory_order_relaxed);
+
+    increment(histogram[binFor(load)], 1u);
+}
+
+void DeadlineMonitor::clear()
+{
+    for (auto* counter : { &callbacks, &over50, &over75, &over90, &overruns,
+                           &totalNanoseconds, &totalDeadlineNanoseconds, &worstNanoseconds })
+        counter->store(0, std::memory_order_relaxed);
+
+    worstLoad.store(0.0, std::memory_order_relaxed);
+
+    for (auto& bin : histogram)
+        bin.store(0, std::memory_order_relaxed);
+}
+
+DeadlineMonitor::Stats DeadlineMonitor::getStats() const
+{
+    Stats stats;
+    stats.callbacks = callbacks.load(std::memory_order_relaxed);
+    stats.over50 = over50.load(std::memory_order_relaxed);
+    stats.over75 = over75.load(std::memory_order_relaxed);
+    stats.over90 = over90.load(std::memory_order_relaxed);
+    stats.overruns = overruns.load(std::memory_order_relaxed);
+
+    const uint64_t deadlineTotal = totalDeadlineNanoseconds.load(std::memory_order_relaxed);
+    stats.meanLoad = deadlineTotal > 0 ? static_cast<double>(totalNanoseconds.load(std::memory_order_relaxed))
+                                             / static_cast<double>(deadlineTotal)
+                                       : 0.0;
+    stats.worstLoad = worstLoad.load(std::memory_order_relaxed);
+    stats.worstCallbackMs = static_cast<double>(worstNanoseconds.load(std::memory_order_relaxed)) * 1.0e-6;
+
+    for (int bin = 0; bin < numBins; ++bin)
+        stats.histogram[bin] = histogram[bin].load(std::memory_order_relaxed);
+
+    return stats;
+}
+
+double DeadlineMonitor::binLowerEdge(int bin)
+{
+    if (bin <= 0)
+        return 0.0;
+
+    return std::exp2(minimumLoadOctave + static_cast<double>(bin - 1) / binsPerOctave);
+}
+
+std::string DeadlineMonitor::formatReport() const
+{
+    const Stats s = getStats();
+    std::string report;
+    char line[160];
+
+    auto percent = [&](uint64_t count)
+    {
+        return s.callbacks > 0 ? 100.0 * static_cast<double>(count) / static_cast<double>(s.callbacks) : 0.0;
+    };
+
+    std::snprintf(line, sizeof(line), "callbacks: %llu\n", static_cast<unsigned long long>(s.callbacks));
+    report += line;
+    std::snprintf(line, sizeof(line), "mean load: %.2f%%\n", 100.0 * s.meanLoad);
+    report += line;
+    std::snprintf(line, sizeof(line), "worst load: %.2f%% (%.3f ms callback)\n", 100.0 * s.worstLoad, s.worstCallbackMs);
+    report += line;
+
+    const struct { const char* name; uint64_t count; } thresholds[] =
+    {
+        { "over 50%", s.over50 }, { "over 75%", s.over75 }, { "over 90%", s.over90 }, { "overruns", s.overruns }
+    };
+
+    for (const auto& t : thresholds)
+    {
+        std::snprintf(line, sizeof(line), "%s: %llu (%.4f%%)\n", t.name,
+                      static_cast<unsigned long long>(t.count), percent(t.count));
+        report += line;
+    }
+
+    report += "load histogram (from, to, callbacks):\n";
+
+    for (int bin = 0; bin < numBins; ++bin)
+    {
+        if (s.histogram[bin] == 0)
+            continue;
+
+        const double from = 100.0 * binLowerEdge(bin);
+        if (bin == numBins - 1)
+            std::snprintf(line, sizeof(line), "  %9.3f%%        -   %llu\n", from,
+                          static_cast<unsigned long long>(s.histogram[bin]));
+        else
+            std::snprintf(line, sizeof(line), "  %9.3f%% %9.3f%%   %llu\n", from, 100.0 * binLowerEdge(bin + 1),
+                          static_cast<unsigned long long>(s.histogram[bin]));
+        report += line;
+    }
+
+    return report;
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/**
+ * Callback deadline / headroom monitor
+ *
+ * Times every audio callback against its deadline (numSamples /
+ * sampleRate) and keeps, per monitor:
+ * - a histogram of load (callback time / deadline), four bins per octave
+ *   from 1/1024 of the deadline to 8x, plus under- and overflow
+ * - near-miss counts above 50%, 75% and 90% of the deadline, and overruns
+ * - the worst load and the worst callback time, and the mean load
+ *
+ * Cheap enough to stay on in release builds: two clock reads and a few
+ * relaxed stores per callback. Every field has a single writer (the audio
+ * thread), so readers on any thread never block it; a report may be off
+ * by the one callback being committed.
+ *
+ * - prepare(): before processing starts
+ * - Scope / record(): the audio thread only
+ * - getStats()/formatReport()/requestReset(): any thread
+ */
+class DeadlineMonitor
+{
+public:
+    static constexpr int binsPerOctave = 4;
+    static constexpr int minimumLoadOctave = -10;     // 1/1024 of the deadline
+    static constexpr int maximumLoadOctave = 3;       // 8x
+    static constexpr int numBins = (maximumLoadOctave - minimumLoadOctave) * binsPerOctave + 2;
+
+    struct Stats
+    {
+        uint64_t callbacks = 0;
+        uint64_t over50 = 0;
+        uint64_t over75 = 0;
+        uint64_t over90 = 0;
+        uint64_t overruns = 0;
+        double meanLoad = 0.0;           // Total callback time / total deadline
+        double worstLoad = 0.0;
+        double worstCallbackMs = 0.0;
+        uint64_t histogram[numBins] {};  // [0] underflow, [numBins - 1] overflow
+    };
+
+    void prepare(double sampleRate);
+
+    // Times the enclosing callback; a scope created with timed = false
+    // (offline rendering has no deadline) records nothing
+    class Scope
+    {
+    public:
+        Scope(DeadlineMonitor& m, int numSamples, bool timed)
+            : monitor(timed ? &m : nullptr), samples(numSamples),
+              start(timed ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point())
+        {
+        }
+
+        ~Scope()
+        {
+            if (monitor != nullptr)
+                monitor->record(std::chrono::steady_clock::now() - start, samples);
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        DeadlineMonitor* monitor;
+        int samples;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    void record(std::chrono::steady_clock::duration elapsed, int numSamples);
+
+    Stats getStats() const;
+
+    // Plain-text report: summary lines, then one line per non-empty bin
+    std::string formatReport() const;
+
+    // Cleared by the audio thread at its next callback
+    void requestReset() { resetRequested.store(true, std::memory_order_relaxed); }
+
+    // Lower edge of a histogram bin, as a fraction of the deadline
+    static double binLowerEdge(int bin);
+
+private:
+    void clear();
+
+    std::atomic<double> nanosecondsPerSample { 1.0e9 / 44100.0 };
+
+    std::atomic<uint64_t> callbacks { 0 };
+    std::atomic<uint64_t> over50 { 0 };
+    std::atomic<uint64_t> over75 { 0 };
+    std::atomic<uint64_t> over90 { 0 };
+    std::atomic<uint64_t> overruns { 0 };
+    std::atomic<uint64_t> totalNanoseconds { 0 };
+    std::atomic<uint64_t> totalDeadlineNanoseconds { 0 };
+    std::atomic<double> worstLoad { 0.0 };
+    std::atomic<uint64_t> worstNanoseconds { 0 };
+    std::atomic<uint32_t> histogram[numBins] {};
+
+    std::atomic<bool> resetRequested { false };
+};
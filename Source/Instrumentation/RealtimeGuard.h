@@ -0,0 +1,47 @@
+#pragma once
+
+// Realtime-safety checking of processBlock; off unless the build sets it
+#ifndef NEVESTRIP_RT_CHECK
+ #define NEVESTRIP_RT_CHECK 0
+#endif
+
+/**
+ * Marks code that must not allocate, free or block
+ *
+ * A Scope only sets a thread-local flag; nothing is checked by itself. The
+ * realtime checker (Tools/RealtimeCheck) interposes malloc/free,
+ * operator new/delete and the pthread lock calls, and reports every call
+ * made on a thread while it is inside a Scope, with a stack trace.
+ *
+ * Use NEVESTRIP_RT_SCOPE so that builds without NEVESTRIP_RT_CHECK carry
+ * nothing at all.
+ */
+namespace RealtimeGuard
+{
+    // Nesting depth of Scopes on this thread
+    inline thread_local int depth = 0;
+
+    // Set while the checker reports, so its own allocations pass
+    inline thread_local bool suspended = false;
+
+    inline bool isActive() { return depth > 0 && ! suspended; }
+
+    class Scope
+    {
+    public:
+        explicit Scope(bool enabled) : counted(enabled) { depth += counted ? 1 : 0; }
+        ~Scope() { depth -= counted ? 1 : 0; }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const bool counted;
+    };
+}
+
+#if NEVESTRIP_RT_CHECK
+ #define NEVESTRIP_RT_SCOPE(enabled) const RealtimeGuard::Scope realtimeScope (enabled)
+#else
+ #define NEVESTRIP_RT_SCOPE(enabled) ((void) 0)
+#endif
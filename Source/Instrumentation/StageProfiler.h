@@ -0,0 +1,220 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+ #include <intrin.h>
+ #define NEVESTRIP_PROFILE_RDTSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+ #include <x86intrin.h>
+ #define NEVESTRIP_PROFILE_RDTSC 1
+#endif
+
+// Per-stage CPU profiling of processBlock; off unless the build sets it
+#ifndef NEVESTRIP_PROFILING
+ #define NEVESTRIP_PROFILING 0
+#endif
+
+/**
+ * Per-stage CPU profiler for a sequential processing chain
+ *
+ * The audio thread takes one timestamp per stage boundary (rdtsc on x86,
+ * steady_clock elsewhere) and commits the laps once per block: per stage a
+ * block count, total ticks and samples, the worst block, and a histogram of
+ * ticks per sample (four bins per octave) for percentiles. Every field has
+ * a single writer and is stored with relaxed atomics, so readers on any
+ * thread never block it; a reader may see one block half-committed.
+ *
+ * Ticks become nanoseconds on the reading side, calibrated against
+ * steady_clock over the time since the profiler was created.
+ *
+ * - beginBlock()/lap()/endBlock(): the audio thread only
+ * - getStats()/requestReset(): any thread
+ *
+ * Use the NEVESTRIP_PROFILE_* macros below so that builds without
+ * NEVESTRIP_PROFILING carry no timing code at all.
+ */
+template <int numStages>
+class StageProfiler
+{
+public:
+    // Nanoseconds per sample (block time / block length)
+    struct Stats
+    {
+        uint64_t blocks = 0;
+        float meanNs = 0.0f;
+        float p99Ns = 0.0f;
+        float maxNs = 0.0f;
+    };
+
+    // Laps of one block, kept on the audio thread's stack
+    struct Block
+    {
+        uint64_t last = 0;
+        uint64_t ticks[numStages] {};
+
+        // Time since the previous lap (or beginBlock) goes to this stage
+        void lap(int stage)
+        {
+            const uint64_t now = readTicks();
+            ticks[stage] += now - last;
+            last = now;
+        }
+    };
+
+    StageProfiler()
+        : startTicks(readTicks()), startTime(std::chrono::steady_clock::now()) {}
+
+    Block beginBlock() const
+    {
+        Block block;
+        block.last = readTicks();
+        return block;
+    }
+
+    void endBlock(const Block& block, int numSamples)
+    {
+        if (numSamples <= 0)
+            return;
+
+        if (resetRequested.exchange(false, std::memory_order_relaxed))
+            clear();
+
+        for (int stage = 0; stage < numStages; ++stage)
+        {
+            Accumulator& a = accumulators[stage];
+            const float perSample = static_cast<float>(block.ticks[stage]) / static_cast<float>(numSamples);
+
+            store(a.blocks, a.blocks.load(std::memory_order_relaxed) + 1);
+            store(a.ticks, a.ticks.load(std::memory_order_relaxed) + block.ticks[stage]);
+            store(a.samples, a.samples.load(std::memory_order_relaxed) + static_cast<uint64_t>(numSamples));
+
+            if (perSample > a.maxTicksPerSample.load(std::memory_order_relaxed))
+                a.maxTicksPerSample.store(perSample, std::memory_order_relaxed);
+
+            auto& bin = a.histogram[binFor(perSample)];
+            store(bin, bin.load(std::memory_order_relaxed) + 1);
+        }
+    }
+
+    Stats getStats(int stage) const
+    {
+        const Accumulator& a = accumulators[stage];
+        const double nsPerTick = nanosecondsPerTick();
+
+        Stats stats;
+        stats.blocks = a.blocks.load(std::memory_order_relaxed);
+
+        const uint64_t samples = a.samples.load(std::memory_order_relaxed);
+        if (stats.blocks == 0 || samples == 0)
+            return stats;
+
+        stats.meanNs = static_cast<float>(static_cast<double>(a.ticks.load(std::memory_order_relaxed))
+                                          / static_cast<double>(samples) * nsPerTick);
+        stats.maxNs = static_cast<float>(a.maxTicksPerSample.load(std::memory_order_relaxed) * nsPerTick);
+
+        // Upper edge of the bin holding the 99th percentile block
+        uint64_t counts[numBins];
+        uint64_t total = 0;
+        for (int bin = 0; bin < numBins; ++bin)
+            total += (counts[bin] = a.histogram[bin].load(std::memory_order_relaxed));
+
+        const uint64_t rank = total - total / 100;
+        uint64_t seen = 0;
+        for (int bin = 0; bin < numBins; ++bin)
+        {
+            seen += counts[bin];
+            if (seen >= rank)
+            {
+                stats.p99Ns = std::min(stats.maxNs, static_cast<float>(binUpperEdge(bin) * nsPerTick));
+                break;
+            }
+        }
+
+        return stats;
+    }
+
+    // Cleared by the audio thread at its next block
+    void requestReset() { resetRequested.store(true, std::memory_order_relaxed); }
+
+    static uint64_t readTicks()
+    {
+       #if NEVESTRIP_PROFILE_RDTSC
+        return static_cast<uint64_t>(__rdtsc());
+       #else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()).count());
+       #endif
+    }
+
+private:
+    static constexpr int binsPerOctave = 4;
+    static constexpr int numBins = 32 * binsPerOctave;
+
+    struct Accumulator
+    {
+        std::atomic<uint64_t> blocks { 0 };
+        std::atomic<uint64_t> ticks { 0 };
+        std::atomic<uint64_t> samples { 0 };
+        std::atomic<float> maxTicksPerSample { 0.0f };
+        std::atomic<uint32_t> histogram[numBins] {};
+    };
+
+    template <typename T, typename V>
+    static void store(std::atomic<T>& field, V value) { field.store(static_cast<T>(value), std::memory_order_relaxed); }
+
+    static int binFor(float ticksPerSample)
+    {
+        if (ticksPerSample < 1.0f)
+            return 0;
+
+        const int bin = static_cast<int>(std::log2(ticksPerSample) * binsPerOctave);
+        return std::min(bin, numBins - 1);
+    }
+
+    static double binUpperEdge(int bin) { return std::exp2(static_cast<double>(bin + 1) / binsPerOctave); }
+
+    void clear()
+    {
+        for (auto& a : accumulators)
+        {
+            store(a.blocks, 0);
+            store(a.ticks, 0);
+            store(a.samples, 0);
+            a.maxTicksPerSample.store(0.0f, std::memory_order_relaxed);
+            for (auto& bin : a.histogram)
+                store(bin, 0);
+        }
+    }
+
+    double nanosecondsPerTick() const
+    {
+       #if NEVESTRIP_PROFILE_RDTSC
+        const double elapsedNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count();
+        const double elapsedTicks = static_cast<double>(readTicks() - startTicks);
+        return elapsedTicks > 0.0 ? elapsedNs / elapsedTicks : 0.0;
+       #else
+        return 1.0;
+       #endif
+    }
+
+    const uint64_t startTicks;
+    const std::chrono::steady_clock::time_point startTime;
+
+    Accumulator accumulators[numStages];
+    std::atomic<bool> resetRequested { false };
+};
+
+#if NEVESTRIP_PROFILING
+ #define NEVESTRIP_PROFILE_BEGIN(profiler, block)          auto block = (profiler).beginBlock()
+ #define NEVESTRIP_PROFILE_LAP(block, stage)               (block).lap(stage)
+ #define NEVESTRIP_PROFILE_END(profiler, block, numSamples) (profiler).endBlock(block, numSamples)
+#else
+ #define NEVESTRIP_PROFILE_BEGIN(profiler, block)          ((void) 0)
+ #define NEVESTRIP_PROFILE_LAP(block, stage)               ((void) 0)
+ #define NEVESTRIP_PROFILE_END(profiler, block, numSamples) ((void) 0)
+#endif
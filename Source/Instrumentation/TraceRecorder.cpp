@@ -0,0 +1,147 @@
+#include "TraceRecorder.h"
+#include <algorithm>
+
+TraceRecorder& TraceRecorder::getInstance()
+{
+    static TraceRecorder instance;
+    return instance;
+}
+
+TraceRecorder::TraceRecorder()
+    : origin(std::chrono::steady_clock::now()), rings(new Ring[maxThreads])
+{
+}
+
+TraceRecorder::~TraceRecorder()
+{
+    stop();
+}
+
+uint64_t TraceRecorder::now()
+{
+    const auto elapsed = std::chrono::steady_clock::now() - getInstance().origin;
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
+
+TraceRecorder::Ring* TraceRecorder::ringForThisThread()
+{
+    // Claimed once per thread; threads beyond maxThreads are not traced
+    thread_local int slot = -2;
+
+    if (slot == -2)
+    {
+        const int claimed = numThreads.fetch_add(1, std::memory_order_relaxed);
+        slot = claimed < maxThreads ? claimed : -1;
+    }
+
+    return slot >= 0 ? &rings[slot] : nullptr;
+}
+
+void TraceRecorder::record(const char* name, uint64_t begin, int64_t duration)
+{
+    if (! isRecording())
+        return;
+
+    if (auto* ring = ringForThisThread())
+        ring->push({ name, begin, duration });
+}
+
+void TraceRecorder::nameThread(const char* name)
+{
+    if (auto* ring = ringForThisThread())
+        threadNames[ring - rings.get()].store(name, std::memory_order_relaxed);
+}
+
+bool TraceRecorder::start(const std::string& path)
+{
+    stop();
+
+    const std::lock_guard<std::mutex> lock(writerLock);
+
+    // Anything left over from an earlier trace is discarded: with no file
+    // open, drain() only empties the rings
+    drain();
+
+    file = std::fopen(path.c_str(), "w");
+    if (file == nullptr)
+        return false;
+
+    std::fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", file);
+    firstEvent = true;
+    droppedEvents = 0;
+
+    stopWriter.store(false);
+    recording.store(true);
+    writer = std::thread([this] { writerLoop(); });
+    return true;
+}
+
+void TraceRecorder::stop()
+{
+    if (! writer.joinable())
+        return;
+
+    recording.store(false);
+    stopWriter.store(true);
+    writer.join();
+
+    const std::lock_guard<std::mutex> lock(writerLock);
+    drain();
+
+    // Thread names, and what full rings cost, as metadata events
+    const int threads = std::min(numThreads.load(), maxThreads);
+    for (int slot = 0; slot < threads; ++slot)
+    {
+        const char* name = threadNames[slot].load(std::memory_order_relaxed);
+        std::fprintf(file, "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                     firstEvent ? "" : ",\n", slot, name != nullptr ? name : "Thread");
+        firstEvent = false;
+    }
+
+    std::fprintf(file, "\n],\"metadata\":{\"droppedEvents\":%llu}}\n", static_cast<unsigned long long>(droppedEvents));
+    std::fclose(file);
+    file = nullptr;
+}
+
+void TraceRecorder::writerLoop()
+{
+    while (! stopWriter.load())
+    {
+        {
+            const std::lock_guard<std::mutex> lock(writerLock);
+            drain();
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+}
+
+void TraceRecorder::drain()
+{
+    const int threads = std::min(numThreads.load(), maxThreads);
+
+    for (int slot = 0; slot < threads; ++slot)
+    {
+        Ring& ring = rings[slot];
+        droppedEvents += ring.getNumDropped();
+
+        Event event;
+        while (ring.pop(event))
+        {
+            if (file == nullptr)
+                continue;
+
+            // Chrome wants microseconds; keep the nanoseconds as decimals
+            const char* separator = firstEvent ? "" : ",\n";
+            firstEvent = false;
+
+            if (event.duration == instantEvent)
+                std::fprintf(file, "%s{\"ph\":\"i\",\"s\":\"t\",\"name\":\"%s\",\"pid\":1,\"tid\":%d,\"ts\":%.3f}",
+                             separator, event.name, slot, static_cast<double>(event.begin) * 1.0e-3);
+            else
+                std::fprintf(file, "%s{\"ph\":\"X\",\"name\":\"%s\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                             separator, event.name, slot, static_cast<double>(event.begin) * 1.0e-3,
+                             static_cast<double>(event.duration) * 1.0e-3);
+        }
+    }
+}
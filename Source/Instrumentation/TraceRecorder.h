@@ -0,0 +1,155 @@
+#pragma once
+
+#include "../DSP/FrameQueue.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Timeline tracing of the audio and UI threads; off unless the build sets it
+#ifndef NEVESTRIP_TRACING
+ #define NEVESTRIP_TRACING 0
+#endif
+
+/**
+ * Chrome trace-event recorder (chrome://tracing, ui.perfetto.dev)
+ *
+ * Each thread that records gets its own preallocated ring on first use, so
+ * recording an event is a clock read and a wait-free push - no locks or
+ * allocation, safe on the audio thread. Events are complete events (begin
+ * timestamp + duration) or instants, named by string literals.
+ *
+ * While a trace is running a writer thread drains every ring about 20
+ * times a second into a trace-event JSON file; a ring that fills between
+ * drains drops events and the count goes into the trace's metadata.
+ *
+ * - Scope/Laps/instant()/nameThread(): any thread, realtime-safe
+ * - start()/stop(): non-realtime threads
+ *
+ * Use the NEVESTRIP_TRACE_* macros below so that builds without
+ * NEVESTRIP_TRACING carry no tracing code at all.
+ */
+class TraceRecorder
+{
+public:
+    static constexpr int maxThreads = 16;
+    static constexpr int eventsPerThread = 16384;
+
+    static TraceRecorder& getInstance();
+
+    ~TraceRecorder();
+
+    // Opens the file and starts recording; false if it cannot be written
+    bool start(const std::string& path);
+
+    // Drains what is left, closes the JSON and the file
+    void stop();
+
+    bool isRecording() const { return recording.load(std::memory_order_relaxed); }
+
+    // Timeline label for the calling thread ("Audio", "Message", ...)
+    void nameThread(const char* name);
+
+    void instant(const char* name) { record(name, now(), instantEvent); }
+
+    // Traces the enclosing scope as one event
+    class Scope
+    {
+    public:
+        explicit Scope(const char* eventName)
+            : name(eventName), begin(getInstance().isRecording() ? now() : notRecording) {}
+
+        ~Scope()
+        {
+            if (begin != notRecording)
+                getInstance().record(name, begin, static_cast<int64_t>(now() - begin));
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const char* name;
+        const uint64_t begin;
+    };
+
+    // Back-to-back sections of one function: each lap() closes the section
+    // that began at the previous lap (or at construction)
+    class Laps
+    {
+    public:
+        Laps() : last(getInstance().isRecording() ? now() : notRecording) {}
+
+        void lap(const char* name)
+        {
+            if (last == notRecording)
+                return;
+
+            const uint64_t time = now();
+            getInstance().record(name, last, static_cast<int64_t>(time - last));
+            last = time;
+        }
+
+    private:
+        uint64_t last;
+    };
+
+private:
+    TraceRecorder();
+
+    struct Event
+    {
+        const char* name = nullptr;
+        uint64_t begin = 0;            // ns since the recorder was created
+        int64_t duration = 0;          // ns, or instantEvent
+    };
+
+    using Ring = FrameQueue<Event, eventsPerThread>;
+
+    static constexpr int64_t instantEvent = -1;
+    static constexpr uint64_t notRecording = ~uint64_t(0);
+
+    static uint64_t now();
+
+    void record(const char* name, uint64_t begin, int64_t duration);
+    Ring* ringForThisThread();
+
+    void writerLoop();
+    void drain();
+
+    const std::chrono::steady_clock::time_point origin;
+
+    std::unique_ptr<Ring[]> rings;
+    std::atomic<const char*> threadNames[maxThreads] {};
+    std::atomic<int> numThreads { 0 };
+
+    std::atomic<bool> recording { false };
+
+    // Writer side, under writerLock
+    std::mutex writerLock;
+    std::thread writer;
+    std::FILE* file = nullptr;
+    bool firstEvent = true;
+    uint64_t droppedEvents = 0;
+    std::atomic<bool> stopWriter { false };
+};
+
+#if NEVESTRIP_TRACING
+ #define NEVESTRIP_TRACE_JOIN2(a, b)              a##b
+ #define NEVESTRIP_TRACE_JOIN(a, b)               NEVESTRIP_TRACE_JOIN2(a, b)
+ #define NEVESTRIP_TRACE_SCOPE(name)              const TraceRecorder::Scope NEVESTRIP_TRACE_JOIN(traceScope, __LINE__) (name)
+ #define NEVESTRIP_TRACE_INSTANT(name)            TraceRecorder::getInstance().instant(name)
+ #define NEVESTRIP_TRACE_THREAD(name)             TraceRecorder::getInstance().nameThread(name)
+ #define NEVESTRIP_TRACE_LAPS(laps)               TraceRecorder::Laps laps
+ #define NEVESTRIP_TRACE_LAP(laps, name)          (laps).lap(name)
+#else
+ #define NEVESTRIP_TRACE_SCOPE(name)              ((void) 0)
+ #define NEVESTRIP_TRACE_INSTANT(name)            ((void) 0)
+ #define NEVESTRIP_TRACE_THREAD(name)             ((void) 0)
+ #define NEVESTRIP_TRACE_LAPS(laps)               ((void) 0)
+ #define NEVESTRIP_TRACE_LAP(laps, name)          ((void) 0)
+#endif
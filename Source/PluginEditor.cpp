@@ -240,15 +240,19 @@ VUMeter::VUMeter()
 {
 }
 
-void VUMeter::setLevel(float newLevel)
+void VUMeter::setLevel(float vuLevel, float peakLevel)
 {
-    level = newLevel;
+    level = vuLevel;
+    peak = peakLevel;
+    NEVESTRIP_TRACE_INSTANT("VUMeter::repaint");
     repaint();
 }
 
-void VUMeter::setGainReduction(float gr)
+void VUMeter::setGainReduction(float deepestDb, float shallowestDb)
 {
-    gainReduction = gr;
+    gainReduction = deepestDb;
+    minGainReduction = shallowestDb;
+    NEVESTRIP_TRACE_INSTANT("VUMeter::repaint");
     repaint();
 }
 
@@ -287,6 +291,7 @@ void VUMeter::drawScaleMarkings(juce::Graphics& g, juce::Rectangle<float> bounds
 
 void VUMeter::paint(juce::Graphics& g)
 {
+    NEVESTRIP_TRACE_SCOPE("VUMeter::paint");
     auto bounds = getLocalBounds().toFloat();
 
     // Leave space for scale markings on the right
@@ -304,27 +309,23 @@ void VUMeter::paint(juce::Graphics& g)
     g.setColour(juce::Colour(0xFF101418));
     g.fillRoundedRectangle(innerBounds, 2.0f);
 
-    // Meter value
-    float displayValue = showGR ? gainReduction : level;
-
-    // Smooth the display (non-const for updating)
-    float targetSmoothed = showGR ? smoothedGR : smoothedLevel;
-    targetSmoothed += 0.25f * (displayValue - targetSmoothed);
-    if (showGR)
-        smoothedGR = targetSmoothed;
-    else
-        smoothedLevel = targetSmoothed;
+    // Convert to display height (ballistics are applied by the editor)
+    auto levelToFill = [](float linear)
+    {
+        float dbLevel = 20.0f * std::log10(std::max(0.0001f, linear));
+        return juce::jlimit(0.0f, 1.0f, (dbLevel + 60.0f) / 66.0f);  // -60 to +6 dB range
+    };
 
-    // Convert to display height
-    float meterFill;
+    float meterFill, markerFill;
     if (showGR)
     {
-        meterFill = std::min(1.0f, smoothedGR / 20.0f);
+        meterFill = std::min(1.0f, gainReduction / 20.0f);
+        markerFill = std::min(1.0f, minGainReduction / 20.0f);
     }
     else
     {
-        float dbLevel = 20.0f * std::log10(std::max(0.0001f, smoothedLevel));
-        meterFill = std::max(0.0f, (dbLevel + 60.0f) / 66.0f);  // -60 to +6 dB range
+        meterFill = levelToFill(level);
+        markerFill = levelToFill(peak);
     }
 
     // Draw meter bar with segments
@@ -382,6 +383,14 @@ void VUMeter::paint(juce::Graphics& g)
         }
     }
 
+    // Peak (or shallowest GR) marker
+    if (markerFill > 0.0f)
+    {
+        float markerY = barBounds.getBottom() - markerFill * barBounds.getHeight();
+        g.setColour(juce::Colour(0xFFE8E0D0).withAlpha(0.85f));
+        g.fillRect(barBounds.getX(), markerY - 1.0f, barBounds.getWidth(), 2.0f);
+    }
+
     // Draw scale markings
     drawScaleMarkings(g, innerBounds);
 
@@ -393,6 +402,129 @@ void VUMeter::paint(juce::Graphics& g)
     g.fillRoundedRectangle(innerBounds.getX(), innerBounds.getY(), innerBounds.getWidth(), 20, 2.0f);
 }
 
+//==============================================================================
+// GainReductionHistory - Scrolling graph rendered one column at a time
+//==============================================================================
+GainReductionHistory::GainReductionHistory()
+{
+    setOpaque(true);
+}
+
+void GainReductionHistory::resized()
+{
+    // Start from an empty graph at the new size
+    const int width = juce::jmax(1, getWidth());
+    const int height = juce::jmax(1, getHeight());
+    history = juce::Image(juce::Image::RGB, width, height, false);
+
+    juce::Graphics g(history);
+    for (int x = 0; x < width; ++x)
+        drawColumn(g, x, 0.0f, 0.0f, 0.0f);
+}
+
+void GainReductionHistory::addColumn(float minimumDb, float maximumDb, float meanDb)
+{
+    if (! history.isValid())
+        return;
+
+    const int width = history.getWidth();
+    history.moveImageSection(0, 0, 1, 0, width - 1, history.getHeight());
+
+    juce::Graphics g(history);
+    drawColumn(g, width - 1, minimumDb, maximumDb, meanDb);
+}
+
+float GainReductionHistory::dbToY(float db) const
+{
+    // GR hangs down from the top edge, 0 to 20 dB
+    return juce::jlimit(0.0f, 1.0f, db / rangeDb) * static_cast<float>(history.getHeight() - 1);
+}
+
+void GainReductionHistory::drawColumn(juce::Graphics& g, int x, float minimumDb, float maximumDb, float meanDb) const
+{
+    const int height = history.getHeight();
+
+    g.setColour(juce::Colour(0xFF101418));
+    g.fillRect(x, 0, 1, height);
+
+    // 5 dB grid
+    g.setColour(juce::Colour(0xFF2A3038));
+    for (float db = 5.0f; db < rangeDb; db += 5.0f)
+        g.fillRect(x, static_cast<int>(dbToY(db)), 1, 1);
+
+    if (maximumDb <= 0.0f)
+        return;
+
+    // Range over the column (dim), filled down from 0 dB, and the mean (bright)
+    const float top = dbToY(juce::jmin(minimumDb, maximumDb));
+    const float bottom = dbToY(maximumDb);
+
+    g.setColour(juce::Colour(0xFFD97030).withAlpha(0.35f));
+    g.fillRect(static_cast<float>(x), 0.0f, 1.0f, top);
+    g.setColour(juce::Colour(0xFFD97030).withAlpha(0.7f));
+    g.fillRect(static_cast<float>(x), top, 1.0f, juce::jmax(1.0f, bottom - top));
+    g.setColour(juce::Colour(0xFFE8E0D0));
+    g.fillRect(static_cast<float>(x), dbToY(meanDb), 1.0f, 1.0f);
+}
+
+void GainReductionHistory::paint(juce::Graphics& g)
+{
+    NEVESTRIP_TRACE_SCOPE("GainReductionHistory::paint");
+    g.drawImageAt(history, 0, 0);
+}
+
+#if NEVESTRIP_PROFILING
+//==============================================================================
+// ProfilerOverlay - Per-stage CPU table
+//==============================================================================
+ProfilerOverlay::ProfilerOverlay(NeveStripAudioProcessor& p) : processor(p)
+{
+}
+
+void ProfilerOverlay::update()
+{
+    for (int stage = 0; stage < NeveStripAudioProcessor::NUM_STAGES; ++stage)
+        stats[stage] = processor.getStageStats(stage);
+
+    repaint();
+}
+
+void ProfilerOverlay::paint(juce::Graphics& g)
+{
+    g.fillAll(juce::Colours::black.withAlpha(0.8f));
+    g.setFont(juce::Font(juce::Font::getDefaultMonospacedFontName(), 10.0f, juce::Font::plain));
+
+    const int rowHeight = 12;
+    auto row = getLocalBounds().reduced(4).removeFromTop(rowHeight);
+
+    auto drawRow = [&](const juce::String& name, const juce::String& mean, const juce::String& p99, const juce::String& max)
+    {
+        auto r = row;
+        g.drawText(name, r.removeFromLeft(80), juce::Justification::left);
+        g.drawText(mean, r.removeFromLeft(50), juce::Justification::right);
+        g.drawText(p99, r.removeFromLeft(50), juce::Justification::right);
+        g.drawText(max, r.removeFromLeft(50), juce::Justification::right);
+        row.translate(0, rowHeight);
+    };
+
+    g.setColour(juce::Colour(0xFFC4983C));
+    drawRow("ns/sample", "mean", "p99", "max");
+
+    g.setColour(juce::Colour(0xFFE8E0D0));
+    float totalMean = 0.0f;
+    for (int stage = 0; stage < NeveStripAudioProcessor::NUM_STAGES; ++stage)
+    {
+        const auto& s = stats[stage];
+        totalMean += s.meanNs;
+        drawRow(NeveStripAudioProcessor::stageNames[stage], juce::String(s.meanNs, 1),
+                juce::String(s.p99Ns, 1), juce::String(s.maxNs, 1));
+    }
+
+    g.setColour(juce::Colour(0xFFD97030));
+    drawRow("Total", juce::String(totalMean, 1), {}, {});
+}
+#endif
+
 //==============================================================================
 // SectionHeader - Realistic Metal Strip Style
 //==============================================================================
@@ -454,6 +586,7 @@ void SectionHeader::paint(juce::Graphics& g)
 //==============================================================================
 void NeveStripContent::paint(juce::Graphics& g)
 {
+    NEVESTRIP_TRACE_SCOPE("NeveStripContent::paint");
     // Content area is painted by the parent editor
     juce::ignoreUnused(g);
 }
@@ -546,10 +679,15 @@ NeveStripAudioProcessorEditor::NeveStripAudioProcessorEditor(NeveStripAudioProce
     masterBypassButton.setLookAndFeel(&neveLookAndFeel);
     contentComponent.addAndMakeVisible(masterBypassButton);
 
+   #if NEVESTRIP_PROFILING
+    addAndMakeVisible(profilerOverlay);
+   #endif
+
     // Meters - these stay in the main editor (fixed position)
     addAndMakeVisible(inputMeter);
     addAndMakeVisible(outputMeter);
     addAndMakeVisible(grMeter);
+    addAndMakeVisible(grHistory);
     grMeter.setShowGR(true);
     addAndMakeVisible(inputMeterLabel);
     addAndMakeVisible(outputMeterLabel);
@@ -557,6 +695,9 @@ NeveStripAudioProcessorEditor::NeveStripAudioProcessorEditor(NeveStripAudioProce
     inputMeterLabel.setJustificationType(juce::Justification::centred);
     outputMeterLabel.setJustificationType(juce::Justification::centred);
     grMeterLabel.setJustificationType(juce::Justification::centred);
+    addAndMakeVisible(truePeakLabel);
+    truePeakLabel.setJustificationType(juce::Justification::centred);
+    truePeakLabel.setInterceptsMouseClicks(false, false);
 
     // Create attachments
     auto& apvts = audioProcessor.getAPVTS();
@@ -620,12 +761,20 @@ NeveStripAudioProcessorEditor::NeveStripAudioProcessorEditor(NeveStripAudioProce
     masterBypassAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
         apvts, "masterBypass", masterBypassButton);
 
+    // The panel covers the editor; its right-clicks come here too
+    contentComponent.addMouseListener(this, false);
+
+    audioProcessor.subscribeMeterFrames();
+    audioProcessor.subscribeTruePeak();
     startTimerHz(30);
 }
 
 NeveStripAudioProcessorEditor::~NeveStripAudioProcessorEditor()
 {
     stopTimer();
+    audioProcessor.unsubscribeMeterFrames();
+    audioProcessor.unsubscribeTruePeak();
+    contentComponent.removeMouseListener(this);
 
     // Clear look and feels
     inputGainSlider.setLookAndFeel(nullptr);
@@ -650,6 +799,76 @@ NeveStripAudioProcessorEditor::~NeveStripAudioProcessorEditor()
     masterBypassButton.setLookAndFeel(nullptr);
 }
 
+void NeveStripAudioProcessorEditor::mouseDown(const juce::MouseEvent& e)
+{
+    if (e.mods.isPopupMenu())
+        showTimingMenu();
+    else if (truePeakLabel.getBounds().contains(e.getEventRelativeTo(this).getPosition()))
+        audioProcessor.resetTruePeakMax();
+}
+
+void NeveStripAudioProcessorEditor::showTimingMenu()
+{
+    const auto stats = audioProcessor.getDeadlineStats();
+
+    juce::PopupMenu menu;
+    menu.addSectionHeader("Callback load: " + juce::String(100.0 * stats.meanLoad, 1) + "% mean, "
+                          + juce::String(100.0 * stats.worstLoad, 1) + "% worst, "
+                          + juce::String(static_cast<juce::int64>(stats.overruns)) + " overruns");
+    menu.addItem("Save timing report...", [this]
+    {
+        reportChooser = std::make_unique<juce::FileChooser>(
+            "Save timing report",
+            juce::File::getSpecialLocation(juce::File::userDocumentsDirectory).getChildFile("NeveStrip timing.txt"),
+            "*.txt");
+
+        reportChooser->launchAsync(juce::FileBrowserComponent::saveMode
+                                       | juce::FileBrowserComponent::canSelectFiles
+                                       | juce::FileBrowserComponent::warnAboutOverwriting,
+                                   [this](const juce::FileChooser& chooser)
+        {
+            const auto file = chooser.getResult();
+            if (file != juce::File() && ! audioProcessor.writeDeadlineReport(file))
+                juce::AlertWindow::showMessageBoxAsync(juce::AlertWindow::WarningIcon, "Timing report",
+                                                       "Could not write " + file.getFullPathName());
+        });
+    });
+    menu.addItem("Reset timing statistics", [this] { audioProcessor.resetDeadlineStats(); });
+
+   #if NEVESTRIP_TRACING
+    auto& trace = TraceRecorder::getInstance();
+    menu.addSeparator();
+
+    if (trace.isRecording())
+    {
+        menu.addItem("Stop trace", [&trace] { trace.stop(); });
+    }
+    else
+    {
+        menu.addItem("Start trace...", [this, &trace]
+        {
+            reportChooser = std::make_unique<juce::FileChooser>(
+                "Write trace to",
+                juce::File::getSpecialLocation(juce::File::userDocumentsDirectory).getChildFile("NeveStrip trace.json"),
+                "*.json");
+
+            reportChooser->launchAsync(juce::FileBrowserComponent::saveMode
+                                           | juce::FileBrowserComponent::canSelectFiles
+                                           | juce::FileBrowserComponent::warnAboutOverwriting,
+                                       [&trace](const juce::FileChooser& chooser)
+            {
+                const auto file = chooser.getResult();
+                if (file != juce::File() && ! trace.start(file.getFullPathName().toStdString()))
+                    juce::AlertWindow::showMessageBoxAsync(juce::AlertWindow::WarningIcon, "Trace",
+                                                           "Could not write " + file.getFullPathName());
+            });
+        });
+    }
+   #endif
+
+    menu.showMenuAsync(juce::PopupMenu::Options().withTargetComponent(this));
+}
+
 void NeveStripAudioProcessorEditor::setupSlider(juce::Slider& slider, juce::Label& label)
 {
     slider.setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
@@ -698,6 +917,7 @@ void NeveStripAudioProcessorEditor::drawBrushedMetalTexture(juce::Graphics& g, j
 
 void NeveStripAudioProcessorEditor::paint(juce::Graphics& g)
 {
+    NEVESTRIP_TRACE_SCOPE("Editor::paint");
     auto bounds = getLocalBounds().toFloat();
 
     // Main faceplate - realistic brushed steel blue-grey
@@ -981,20 +1201,113 @@ void NeveStripAudioProcessorEditor::resized()
     int outY = meterStartY + meterSpacing;
     outputMeterLabel.setBounds(meterX, outY, meterAreaWidth - 16, labelHeight);
     outputMeter.setBounds(meterX, outY + labelHeight + 2, meterAreaWidth - 16, meterHeight);
+    truePeakLabel.setBounds(meterX, outY + labelHeight + 2 + meterHeight + 2, meterAreaWidth - 16, labelHeight);
 
     // GR meter
     int grY = meterStartY + meterSpacing * 2;
     grMeterLabel.setBounds(meterX, grY, meterAreaWidth - 16, labelHeight);
     grMeter.setBounds(meterX, grY + labelHeight + 2, meterAreaWidth - 16, meterHeight);
+
+    // GR history under the GR meter
+    int historyY = grY + labelHeight + 2 + meterHeight + 6;
+    grHistory.setBounds(meterX, historyY, meterAreaWidth - 16, juce::jmax(0, juce::jmin(60, getHeight() - 16 - historyY)));
+
+   #if NEVESTRIP_PROFILING
+    // Over the controls, below the title bar
+    profilerOverlay.setBounds(4, 64, 240, 12 * (NeveStripAudioProcessor::NUM_STAGES + 2) + 8);
+   #endif
 }
 
 void NeveStripAudioProcessorEditor::timerCallback()
 {
-    inputMeter.setLevel(audioProcessor.getInputLevel());
-    outputMeter.setLevel(audioProcessor.getOutputLevel());
-    grMeter.setGainReduction(audioProcessor.getCompressorGR() + audioProcessor.getLimiterGR());
+    NEVESTRIP_TRACE_THREAD("Message");
+    NEVESTRIP_TRACE_SCOPE("Editor::timerCallback");
+    const double sampleRate = audioProcessor.getSampleRate() > 0.0 ? audioProcessor.getSampleRate() : 44100.0;
+    const juce::uint32 now = juce::Time::getMillisecondCounter();
+
+    // Every block since the last tick, in order, for its own duration
+    NeveStripAudioProcessor::MeterFrame frame;
+    float tickShallowestGR = std::numeric_limits<float>::max();
+    bool anyFrames = false;
 
-    inputMeter.repaint();
-    outputMeter.repaint();
-    grMeter.repaint();
+    while (audioProcessor.popMeterFrame(frame))
+    {
+        const double seconds = frame.numSamples / sampleRate;
+
+        inputVU.advance(std::sqrt(frame.inputMeanSquare), seconds);
+        outputVU.advance(std::sqrt(frame.outputMeanSquare), seconds);
+        inputPPM.advance(frame.inputPeak, seconds);
+        outputPPM.advance(frame.outputPeak, seconds);
+
+        // GR held as a linear factor, so the PPM fall is 20 dB in 1.7 s here too
+        grHold.advance(juce::Decibels::decibelsToGain(frame.compressorGR.maximum + frame.limiterGR.maximum), seconds);
+        tickShallowestGR = std::min(tickShallowestGR, frame.compressorGR.minimum + frame.limiterGR.minimum);
+
+        addToHistory({ frame.compressorGR.minimum + frame.limiterGR.minimum,
+                       frame.compressorGR.maximum + frame.limiterGR.maximum,
+                       frame.compressorGR.mean + frame.limiterGR.mean }, seconds);
+
+        anyFrames = true;
+    }
+
+    if (anyFrames)
+    {
+        shallowestGR = tickShallowestGR;
+        lastFrameTime = now;
+    }
+    else if (now - lastFrameTime > 250)
+    {
+        // Transport stopped (no blocks at all): let the meters fall
+        const double seconds = getTimerInterval() * 0.001;
+        inputVU.advance(0.0f, seconds);
+        outputVU.advance(0.0f, seconds);
+        inputPPM.advance(0.0f, seconds);
+        outputPPM.advance(0.0f, seconds);
+        grHold.advance(1.0f, seconds);
+        addToHistory({}, seconds);
+    }
+
+    const float heldGR = juce::Decibels::gainToDecibels(std::max(1.0f, grHold.getLevel()));
+
+    inputMeter.setLevel(inputVU.getLevel(), inputPPM.getLevel());
+    outputMeter.setLevel(outputVU.getLevel(), outputPPM.getLevel());
+    grMeter.setGainReduction(heldGR, std::min(shallowestGR, heldGR));
+
+    // Held true peak, red once it goes over 0 dBTP
+    const float truePeak = audioProcessor.getOutputTruePeakMax();
+    if (truePeak != shownTruePeak)
+    {
+        shownTruePeak = truePeak;
+        truePeakLabel.setText(truePeak > 0.0f ? "TP " + juce::String(juce::Decibels::gainToDecibels(truePeak), 1)
+                                              : juce::String("TP -inf"),
+                              juce::dontSendNotification);
+        truePeakLabel.setColour(juce::Label::textColourId,
+                                truePeak > 1.0f ? juce::Colour(neveRed) : juce::Colour(0xFFE0D8C8));
+    }
+
+   #if NEVESTRIP_PROFILING
+    // Twice a second is plenty for a table of averages
+    if (++profilerTicks >= 15)
+    {
+        profilerTicks = 0;
+        profilerOverlay.update();
+    }
+   #endif
+}
+
+void NeveStripAudioProcessorEditor::addToHistory(const GainReductionStats& gr, double seconds)
+{
+    auto& column = historyColumn;
+    column.minimum = std::min(column.minimum, gr.minimum);
+    column.maximum = std::max(column.maximum, gr.maximum);
+    column.weightedMean += gr.mean * seconds;
+    column.seconds += seconds;
+
+    // Blocks are not split across columns; a long block just fills its column
+    if (column.seconds >= GainReductionHistory::secondsPerColumn)
+    {
+        grHistory.addColumn(column.minimum, column.maximum, static_cast<float>(column.weightedMean / column.seconds));
+        grHistory.repaint();
+        column = {};
+    }
 }
@@ -2,6 +2,7 @@
 
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
+#include "DSP/MeterBallistics.h"
 
 //==============================================================================
 // Neve-style LookAndFeel with Chicken Head Knobs
@@ -37,25 +38,72 @@ private:
 //==============================================================================
 // Classic VU Meter Component (Analog Style) - Wider with Scale Markings
 //==============================================================================
+// Draws readings the editor has already run through MeterBallistics: the
+// bar is the VU (or held GR), the marker the PPM peak (or shallowest GR)
 class VUMeter : public juce::Component
 {
 public:
     VUMeter();
     void paint(juce::Graphics& g) override;
-    void setLevel(float newLevel);
-    void setGainReduction(float gr);
+    void setLevel(float vuLevel, float peakLevel);
+    void setGainReduction(float deepestDb, float shallowestDb);
     void setShowGR(bool show) { showGR = show; }
 
 private:
     float level = 0.0f;
+    float peak = 0.0f;
     float gainReduction = 0.0f;
-    float smoothedLevel = 0.0f;
-    float smoothedGR = 0.0f;
+    float minGainReduction = 0.0f;
     bool showGR = false;
 
     void drawScaleMarkings(juce::Graphics& g, juce::Rectangle<float> bounds);
 };
 
+//==============================================================================
+// Scrolling Gain Reduction History
+//==============================================================================
+// Keeps the graph in a cached image: a new column shifts the image one
+// pixel left and draws only that column, so a repaint is a single blit
+class GainReductionHistory : public juce::Component
+{
+public:
+    GainReductionHistory();
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+    // One column: the GR range and mean over its span (dB)
+    void addColumn(float minimumDb, float maximumDb, float meanDb);
+
+    static constexpr double secondsPerColumn = 0.1;
+
+private:
+    void drawColumn(juce::Graphics& g, int x, float minimumDb, float maximumDb, float meanDb) const;
+    float dbToY(float db) const;
+
+    juce::Image history;
+    static constexpr float rangeDb = 20.0f;
+};
+
+#if NEVESTRIP_PROFILING
+//==============================================================================
+// Per-stage CPU overlay (profiling builds only); click to reset the stats
+//==============================================================================
+class ProfilerOverlay : public juce::Component
+{
+public:
+    explicit ProfilerOverlay(NeveStripAudioProcessor& p);
+    void paint(juce::Graphics& g) override;
+    void mouseUp(const juce::MouseEvent&) override { processor.resetStageStats(); }
+
+    // Fetch fresh statistics and repaint
+    void update();
+
+private:
+    NeveStripAudioProcessor& processor;
+    NeveStripAudioProcessor::StageStats stats[NeveStripAudioProcessor::NUM_STAGES];
+};
+#endif
+
 //==============================================================================
 // Section Header Component (Metal Strip Style)
 //==============================================================================
@@ -92,9 +140,16 @@ public:
     void resized() override;
     void timerCallback() override;
 
+    // Right-click on the panel: timing report (and trace) menu; click on
+    // the true peak readout: reset its hold
+    void mouseDown(const juce::MouseEvent& e) override;
+
 private:
     NeveStripAudioProcessor& audioProcessor;
 
+    void showTimingMenu();
+    std::unique_ptr<juce::FileChooser> reportChooser;
+
     // Viewport for scrolling
     juce::Viewport viewport;
     NeveStripContent contentComponent;
@@ -175,10 +230,38 @@ private:
     VUMeter inputMeter;
     VUMeter outputMeter;
     VUMeter grMeter;
+
+    // Ballistics, advanced by every meter frame the processor pushes
+    MeterBallistics::VolumeUnit inputVU, outputVU;
+    MeterBallistics::PeakProgramme inputPPM, outputPPM;
+    MeterBallistics::PeakProgramme grHold { 0.0 };
+    float shallowestGR = 0.0f;
+    juce::uint32 lastFrameTime = 0;
+
+    // GR history: statistics of the column being filled
+    GainReductionHistory grHistory;
+    struct HistoryColumn
+    {
+        float minimum = std::numeric_limits<float>::max();
+        float maximum = 0.0f;
+        double weightedMean = 0.0;
+        double seconds = 0.0;
+    } historyColumn;
+
+    void addToHistory(const GainReductionStats& gr, double seconds);
+
+   #if NEVESTRIP_PROFILING
+    ProfilerOverlay profilerOverlay { audioProcessor };
+    int profilerTicks = 0;
+   #endif
     juce::Label inputMeterLabel { {}, "IN" };
     juce::Label outputMeterLabel { {}, "OUT" };
     juce::Label grMeterLabel { {}, "GR" };
 
+    // Held output true peak (dBTP) under the OUT meter
+    juce::Label truePeakLabel { {}, "TP -inf" };
+    float shownTruePeak = 0.0f;
+
     // Parameter attachments
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> inputGainAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> outputTrimAttachment;
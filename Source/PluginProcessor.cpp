@@ -1,6 +1,32 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 #include "DSP/DSPUtils.h"
+#include "DSP/SIMDTypes.h"
+
+const char* const NeveStripAudioProcessor::parameterIDs[NUM_PARAMETERS] =
+{
+    "inputGain", "outputTrim", "phase", "hpfFreq",
+    "hfFreq", "hfGain", "hmFreq", "hmGain",
+    "lmFreq", "lmGain", "lfFreq", "lfGain",
+    "eqBypass", "eqPrePost",
+    "compThreshold", "compRatio", "compAttack", "compRelease",
+    "compMakeup", "compSCHPF", "compLink", "compBypass", "compControlRate",
+    "limThreshold", "limBypass", "limMode",
+    "transformerDrive", "transformerQuality",
+    "osFactor", "osMode", "transformerAA",
+    "outputLevel", "masterBypass"
+};
+
+const char* const NeveStripAudioProcessor::stageNames[NUM_STAGES] =
+{
+    "Input", "HPF", "Transformer", "Trim",
+    "EQ", "Compressor", "Limiter", "Output"
+};
+
+// End of one processBlock stage, for the profiler and the trace
+#define STAGE_DONE(stage) \
+    NEVESTRIP_PROFILE_LAP(profile, stage); \
+    NEVESTRIP_TRACE_LAP(traceLaps, stageNames[stage])
 
 NeveStripAudioProcessor::NeveStripAudioProcessor()
     : AudioProcessor(BusesProperties()
@@ -14,6 +40,7 @@ NeveStripAudioProcessor::NeveStripAudioProcessor()
     phase = apvts.getRawParameterValue("phase");
     hpfFreq = apvts.getRawParameterValue("hpfFreq");
     transformerDrive = apvts.getRawParameterValue("transformerDrive");
+    transformerQuality = apvts.getRawParameterValue("transformerQuality");
 
     // === EQ SECTION ===
     hfFreq = apvts.getRawParameterValue("hfFreq");
@@ -36,16 +63,39 @@ NeveStripAudioProcessor::NeveStripAudioProcessor()
     compSCHPF = apvts.getRawParameterValue("compSCHPF");
     compLink = apvts.getRawParameterValue("compLink");
     compBypass = apvts.getRawParameterValue("compBypass");
+    compControlRate = apvts.getRawParameterValue("compControlRate");
 
     limThreshold = apvts.getRawParameterValue("limThreshold");
     limBypass = apvts.getRawParameterValue("limBypass");
+    limMode = apvts.getRawParameterValue("limMode");
+
+    // === OVERSAMPLING ===
+    osFactor = apvts.getRawParameterValue("osFactor");
+    osMode = apvts.getRawParameterValue("osMode");
+    transformerAA = apvts.getRawParameterValue("transformerAA");
 
     // === OUTPUT ===
     outputLevel = apvts.getRawParameterValue("outputLevel");
     masterBypass = apvts.getRawParameterValue("masterBypass");
+
+    for (auto* id : parameterIDs)
+        apvts.addParameterListener(id, this);
+
+    moduleParameterService->add(*this);
+    startTimerHz(30);
 }
 
-NeveStripAudioProcessor::~NeveStripAudioProcessor() {}
+NeveStripAudioProcessor::~NeveStripAudioProcessor()
+{
+    // Returns once the service is not in the middle of this instance
+    moduleParameterService->remove(*this);
+
+    for (auto* id : parameterIDs)
+        apvts.removeParameterListener(id, this);
+
+    cancelPendingUpdate();
+    stopTimer();
+}
 
 juce::AudioProcessorValueTreeState::ParameterLayout NeveStripAudioProcessor::createParameterLayout()
 {
@@ -172,6 +222,35 @@ juce::AudioProcessorValueTreeState::ParameterLayout NeveStripAudioProcessor::cre
     params.push_back(std::make_unique<juce::AudioParameterBool>(
         juce::ParameterID("masterBypass", 1), "Master Bypass", false));
 
+    // === ENGINE OPTIONS ===
+    // Appended so existing host parameter indices stay put
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID("compControlRate", 1), "Comp Control-Rate GR", false));
+
+    // Oversampling of the nonlinear stages (transformer, limiter clipper)
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID("osFactor", 1), "Oversampling",
+        juce::StringArray{ "1x", "2x", "4x", "8x" }, 0));
+
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID("osMode", 1), "Oversampling Filter",
+        juce::StringArray{ "IIR Min Phase", "FIR Linear Phase" }, 0));
+
+    // Antiderivative anti-aliasing of the transformer saturator
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID("transformerAA", 1), "Transformer Anti-Aliasing",
+        juce::StringArray{ "Off", "ADAA 1st Order" }, 0));
+
+    // Transformer curve evaluation (tables are rebuilt when drive moves)
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID("transformerQuality", 1), "Transformer Shaper",
+        juce::StringArray{ "Analytic", "Linear Table", "Cubic Table" }, 2));
+
+    // Lookahead true-peak limiting (adds latency)
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID("limMode", 1), "Limiter Mode",
+        juce::StringArray{ "Classic", "Lookahead True Peak" }, 0));
+
     return { params.begin(), params.end() };
 }
 
@@ -189,16 +268,44 @@ void NeveStripAudioProcessor::changeProgramName(int index, const juce::String& n
 void NeveStripAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
     // Prepare DSP modules
-    transformer.prepare(sampleRate, samplesPerBlock);
     hpf.prepare(sampleRate, samplesPerBlock);
     eq.prepare(sampleRate, samplesPerBlock);
-    compressor.prepare(sampleRate, samplesPerBlock);
-    limiter.prepare(sampleRate, samplesPerBlock);
+
+    {
+        // These publish coefficient snapshots - keep the parameter service out
+        const juce::ScopedLock sl(moduleParameterLock);
+        transformer.prepare(sampleRate, samplesPerBlock);
+        compressor.prepare(sampleRate, samplesPerBlock);
+        limiter.prepare(sampleRate, samplesPerBlock);
+    }
+
+    {
+        // Half a second of output in flight is far more than the timer needs
+        const juce::ScopedLock sl(analysisLock);
+        const int fifoSize = juce::jmax(samplesPerBlock * 4, juce::roundToInt(sampleRate * 0.5));
+        analysisBuffer.setSize(2, fifoSize);
+        analysisFifo.setTotalSize(fifoSize);
+        analysisFifo.reset();
+        loudnessMeter.prepare(sampleRate, samplesPerBlock);
+        truePeakRunning = false;
+        analysisOverflowed.store(false);
+        droppedAtLoudnessStart.store(droppedAnalysisSamples.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    deadlineMonitor.prepare(sampleRate);
+    preparedBlockSize = samplesPerBlock;
 
     // Prepare smoothed values
     smoothInputGain.reset(sampleRate, 0.02);
     smoothOutputTrim.reset(sampleRate, 0.02);
     smoothOutputLevel.reset(sampleRate, 0.02);
+
+    // Push every current parameter value into the freshly prepared modules
+    pendingParameterChanges.fetch_or(allParametersChanged & ~offThreadParameters);
+    pendingModuleChanges.fetch_or(offThreadParameters);
+
+    if (applyPendingModuleChanges())
+        updateLatency();
 }
 
 void NeveStripAudioProcessor::releaseResources()
@@ -220,145 +327,514 @@ bool NeveStripAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts)
     return true;
 }
 
-void NeveStripAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+void NeveStripAudioProcessor::parameterChanged(const juce::String& parameterID, float /*newValue*/)
 {
-    juce::ignoreUnused(midiMessages);
-    juce::ScopedNoDenormals noDenormals;
+    for (int i = 0; i < NUM_PARAMETERS; ++i)
+    {
+        if (parameterID == parameterIDs[i])
+        {
+            const uint64_t bit = uint64_t(1) << i;
+            NEVESTRIP_TRACE_INSTANT(parameterIDs[i]);
 
-    auto totalNumInputChannels = getTotalNumInputChannels();
-    auto totalNumOutputChannels = getTotalNumOutputChannels();
+            // Host automation arrives here on the audio thread: set the bit, nothing else
+            auto& mask = (bit & offThreadParameters) != 0 ? pendingModuleChanges : pendingParameterChanges;
+            mask.fetch_or(bit, std::memory_order_release);
+            return;
+        }
+    }
+}
 
-    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
-        buffer.clear(i, 0, buffer.getNumSamples());
+void NeveStripAudioProcessor::applyParameterChanges(uint64_t changes)
+{
+    NEVESTRIP_TRACE_SCOPE("applyParameterChanges");
+    auto changed = [changes](ParameterIndex index) { return (changes & (uint64_t(1) << index)) != 0; };
+
+    // === PREAMP SECTION ===
+    if (changed(PARAM_INPUT_GAIN))
+        smoothInputGain.setTargetValue(DSPUtils::decibelsToLinear(inputGain->load()));
+    if (changed(PARAM_OUTPUT_TRIM))
+        smoothOutputTrim.setTargetValue(DSPUtils::decibelsToLinear(outputTrim->load()));
+    if (changed(PARAM_PHASE))
+        phaseInverted = phase->load() > 0.5f;
+    if (changed(PARAM_HPF_FREQ))
+        hpf.setFrequency(static_cast<int>(hpfFreq->load()));
+
+    // === EQ SECTION ===
+    if (changed(PARAM_HF_FREQ))  eq.setHFFreq(static_cast<int>(hfFreq->load()));
+    if (changed(PARAM_HF_GAIN))  eq.setHFGain(hfGain->load());
+    if (changed(PARAM_HM_FREQ))  eq.setHMFreq(static_cast<int>(hmFreq->load()));
+    if (changed(PARAM_HM_GAIN))  eq.setHMGain(hmGain->load());
+    if (changed(PARAM_LM_FREQ))  eq.setLMFreq(static_cast<int>(lmFreq->load()));
+    if (changed(PARAM_LM_GAIN))  eq.setLMGain(lmGain->load());
+    if (changed(PARAM_LF_FREQ))  eq.setLFFreq(static_cast<int>(lfFreq->load()));
+    if (changed(PARAM_LF_GAIN))  eq.setLFGain(lfGain->load());
+    if (changed(PARAM_EQ_BYPASS))
+        eq.setBypass(eqBypass->load() > 0.5f);
+    if (changed(PARAM_EQ_PRE_POST))
+        eqPost = eqPrePost->load() > 0.5f;
+
+    // === OUTPUT ===
+    if (changed(PARAM_OUTPUT_LEVEL))
+        smoothOutputLevel.setTargetValue(DSPUtils::decibelsToLinear(outputLevel->load()));
+    if (changed(PARAM_MASTER_BYPASS))
+        masterBypassed = masterBypass->load() > 0.5f;
+}
+
+NeveStripAudioProcessor::ModuleParameterService::ModuleParameterService()
+    : juce::Thread("NeveStrip parameters")
+{
+    startThread();
+}
 
-    // Check master bypass
-    if (masterBypass->load() > 0.5f)
+NeveStripAudioProcessor::ModuleParameterService::~ModuleParameterService()
+{
+    stopThread(1000);
+}
+
+void NeveStripAudioProcessor::ModuleParameterService::add(NeveStripAudioProcessor& processor)
+{
+    const juce::ScopedLock sl(instancesLock);
+    instances.addIfNotAlreadyThere(&processor);
+}
+
+void NeveStripAudioProcessor::ModuleParameterService::remove(NeveStripAudioProcessor& processor)
+{
+    const juce::ScopedLock sl(instancesLock);
+    instances.removeFirstMatchingValue(&processor);
+}
+
+void NeveStripAudioProcessor::ModuleParameterService::run()
+{
+    while (! threadShouldExit())
+    {
+        wait(pollIntervalMs);
+
+        const juce::ScopedLock sl(instancesLock);
+        for (auto* processor : instances)
+            if (processor->applyPendingModuleChanges())
+                processor->triggerAsyncUpdate();
+    }
+}
+
+void NeveStripAudioProcessor::handleAsyncUpdate()
+{
+    updateLatency();
+}
+
+bool NeveStripAudioProcessor::applyPendingModuleChanges()
+{
+    // Polled: almost every call finds nothing and skips the lock
+    if (pendingModuleChanges.load(std::memory_order_relaxed) == 0)
+        return false;
+
+    const juce::ScopedLock sl(moduleParameterLock);
+
+    if (auto changes = pendingModuleChanges.exchange(0, std::memory_order_acquire))
+        return applyModuleParameterChanges(changes);
+
+    return false;
+}
+
+bool NeveStripAudioProcessor::applyModuleParameterChanges(uint64_t changes)
+{
+    NEVESTRIP_TRACE_SCOPE("applyModuleParameterChanges");
+    auto changed = [changes](ParameterIndex index) { return (changes & (uint64_t(1) << index)) != 0; };
+
+    // === DYNAMICS SECTION ===
+    if (changed(PARAM_COMP_THRESHOLD)) compressor.setThreshold(compThreshold->load());
+    if (changed(PARAM_COMP_RATIO))     compressor.setRatio(static_cast<int>(compRatio->load()));
+    if (changed(PARAM_COMP_ATTACK))    compressor.setAttack(static_cast<int>(compAttack->load()));
+    if (changed(PARAM_COMP_RELEASE))   compressor.setRelease(static_cast<int>(compRelease->load()));
+    if (changed(PARAM_COMP_MAKEUP))    compressor.setMakeup(compMakeup->load());
+    if (changed(PARAM_COMP_SC_HPF))    compressor.setSidechainHPF(compSCHPF->load() > 0.5f);
+    if (changed(PARAM_COMP_LINK))      compressor.setStereoLink(compLink->load() > 0.5f);
+    if (changed(PARAM_COMP_BYPASS))    compressor.setBypass(compBypass->load() > 0.5f);
+    if (changed(PARAM_COMP_CONTROL_RATE)) compressor.setControlRate(compControlRate->load() > 0.5f);
+
+    if (changed(PARAM_LIM_THRESHOLD))  limiter.setThreshold(limThreshold->load());
+    if (changed(PARAM_LIM_BYPASS))     limiter.setBypass(limBypass->load() > 0.5f);
+    if (changed(PARAM_LIM_MODE))       limiter.setLookahead(limMode->load() > 0.5f);
+
+    // === TRANSFORMER ===
+    if (changed(PARAM_TRANSFORMER_DRIVE))   transformer.setDrive(transformerDrive->load());
+    if (changed(PARAM_TRANSFORMER_QUALITY))
+        transformer.setQuality(static_cast<Transformer::Quality>(static_cast<int>(transformerQuality->load())));
+
+    // === ANTI-ALIASING ===
+    if (changed(PARAM_OS_FACTOR) || changed(PARAM_OS_MODE) || changed(PARAM_TRANSFORMER_AA))
+    {
+        const int stages = static_cast<int>(osFactor->load());
+        const auto mode = osMode->load() > 0.5f ? Oversampler::MODE_FIR : Oversampler::MODE_IIR;
+
+        transformer.setOversampling(stages, mode);
+        transformer.setAntiAliasing(static_cast<ADAATanh::Order>(static_cast<int>(transformerAA->load())));
+        limiter.setOversampling(stages, mode);
+    }
+
+    return changed(PARAM_OS_FACTOR) || changed(PARAM_OS_MODE) || changed(PARAM_TRANSFORMER_AA) || changed(PARAM_LIM_MODE);
+}
+
+void NeveStripAudioProcessor::updateLatency()
+{
+    const int stages = static_cast<int>(osFactor->load());
+    const auto mode = osMode->load() > 0.5f ? Oversampler::MODE_FIR : Oversampler::MODE_IIR;
+    const auto antiAliasing = static_cast<ADAATanh::Order>(static_cast<int>(transformerAA->load()));
+
+    int limiterLatency = 0;
+    {
+        // The parameter service writes the limiter's mode and rate under this lock
+        const juce::ScopedLock sl(moduleParameterLock);
+        limiterLatency = limiter.getLatencySamples();
+    }
+
+    // Both stages resample, bypassed or not; ADAA runs at the transformer's
+    // oversampled rate; the limiter's lookahead delay runs even when bypassed
+    const float latency = 2.0f * Oversampler::getLatencySamples(stages, mode)
+                        + ADAATanh::getDelaySamples(antiAliasing) / static_cast<float>(1 << stages)
+                        + static_cast<float>(limiterLatency);
+
+    setLatencySamples(juce::roundToInt(latency));
+}
+
+// Peak and energy of a block for the meter frames, over all channels
+struct BlockLevel
+{
+    float peak = 0.0f;
+    float sumOfSquares = 0.0f;
+};
+
+// samples *= gain; with a level to fill, the same pass measures the
+// signal before or after the gain
+static void scaleAndMeasure(float* samples, int numSamples, float gain, BlockLevel* level, bool measureAfterGain)
+{
+    using SIMD::Float4;
+
+    if (level == nullptr)
+    {
+        juce::FloatVectorOperations::multiply(samples, gain, numSamples);
         return;
+    }
 
-    const int numSamples = buffer.getNumSamples();
+    const Float4 zero = Float4::broadcast(0.0f);
+    const Float4 gain4 = Float4::broadcast(gain);
+    Float4 peak = zero;
+    Float4 sum = zero;
 
-    // Measure input level
-    float inLevel = 0.0f;
-    for (int ch = 0; ch < totalNumInputChannels; ++ch)
-        inLevel = std::max(inLevel, buffer.getMagnitude(ch, 0, numSamples));
-    inputLevelMeter.store(inLevel);
+    int i = 0;
+    for (; i + 4 <= numSamples; i += 4)
+    {
+        const Float4 x = Float4::load(samples + i);
+        const Float4 y = x * gain4;
+        const Float4 measured = measureAfterGain ? y : x;
 
-    // === PREAMP SECTION ===
+        peak = max(peak, max(measured, zero - measured));
+        sum = sum + measured * measured;
+        y.store(samples + i);
+    }
+
+    float tailPeak = peak.horizontalMax();
+    float tailSum = sum.horizontalSum();
+
+    for (; i < numSamples; ++i)
+    {
+        const float y = samples[i] * gain;
+        const float measured = measureAfterGain ? y : samples[i];
 
-    // Input Gain
-    float targetInputGain = DSPUtils::decibelsToLinear(inputGain->load());
-    smoothInputGain.setTargetValue(targetInputGain);
+        tailPeak = std::max(tailPeak, std::abs(measured));
+        tailSum += measured * measured;
+        samples[i] = y;
+    }
 
-    // Output Trim
-    float targetOutputTrim = DSPUtils::decibelsToLinear(outputTrim->load());
-    smoothOutputTrim.setTargetValue(targetOutputTrim);
+    level->peak = std::max(level->peak, tailPeak);
+    level->sumOfSquares += tailSum;
+}
 
-    // Apply input gain with smoothing
-    for (int ch = 0; ch < totalNumInputChannels; ++ch)
+// Smoothed gain (times sign) over the first numChannels channels: channel 0
+// advances the ramp, the others take its final value. Measures as above.
+static void applySmoothedGain(juce::AudioBuffer<float>& buffer, int numChannels,
+                              juce::SmoothedValue<float>& gain, float sign,
+                              BlockLevel* level, bool measureAfterGain)
+{
+    const int numSamples = buffer.getNumSamples();
+
+    for (int ch = 0; ch < numChannels; ++ch)
     {
         float* data = buffer.getWritePointer(ch);
+
+        if (ch > 0 || ! gain.isSmoothing())
+        {
+            scaleAndMeasure(data, numSamples, sign * gain.getCurrentValue(), level, measureAfterGain);
+            continue;
+        }
+
+        if (level == nullptr)
+        {
+            for (int i = 0; i < numSamples; ++i)
+                data[i] *= sign * gain.getNextValue();
+            continue;
+        }
+
+        float peak = 0.0f;
+        float sumOfSquares = 0.0f;
+
         for (int i = 0; i < numSamples; ++i)
         {
-            float gain = (ch == 0) ? smoothInputGain.getNextValue() : smoothInputGain.getCurrentValue();
-            data[i] *= gain;
+            const float x = data[i];
+            const float y = x * (sign * gain.getNextValue());
+            const float measured = measureAfterGain ? y : x;
+
+            peak = std::max(peak, std::abs(measured));
+            sumOfSquares += measured * measured;
+            data[i] = y;
         }
+
+        level->peak = std::max(level->peak, peak);
+        level->sumOfSquares += sumOfSquares;
     }
+}
+
+void NeveStripAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    juce::ignoreUnused(midiMessages);
+    juce::ScopedNoDenormals noDenormals;
 
-    // Phase inversion
-    if (phase->load() > 0.5f)
+    // Times the whole callback, bypass included
+    const DeadlineMonitor::Scope deadlineScope(deadlineMonitor, buffer.getNumSamples(), ! isNonRealtime());
+    NEVESTRIP_RT_SCOPE(! isNonRealtime());
+    NEVESTRIP_TRACE_THREAD("Audio");
+    NEVESTRIP_TRACE_SCOPE("processBlock");
+
+    auto totalNumInputChannels = getTotalNumInputChannels();
+    auto totalNumOutputChannels = getTotalNumOutputChannels();
+
+    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
+        buffer.clear(i, 0, buffer.getNumSamples());
+
+    // Offline renders have no deadline: apply module changes synchronously
+    // instead of waiting for the parameter service
+    if (isNonRealtime() && applyPendingModuleChanges())
+        updateLatency();
+
+    // Pick up parameter changes since the last block (usually none)
+    if (auto changes = pendingParameterChanges.exchange(0, std::memory_order_acquire))
+        applyParameterChanges(changes);
+
+    const int numSamples = buffer.getNumSamples();
+
+    // Without a subscriber the gain passes skip the level measurement
+    const bool metering = meterSubscribers.load(std::memory_order_relaxed) > 0;
+    BlockLevel inputLevel, outputLevel;
+
+    // Check master bypass (the meters still follow the untouched signal)
+    if (masterBypassed)
     {
-        for (int ch = 0; ch < totalNumInputChannels; ++ch)
+        if (metering)
         {
-            float* data = buffer.getWritePointer(ch);
-            for (int i = 0; i < numSamples; ++i)
-                data[i] = -data[i];
+            for (int ch = 0; ch < totalNumInputChannels; ++ch)
+                scaleAndMeasure(buffer.getWritePointer(ch), numSamples, 1.0f, &inputLevel, false);
+
+            pushMeterFrame(numSamples, totalNumInputChannels, inputLevel.peak, inputLevel.sumOfSquares,
+                           inputLevel.peak, inputLevel.sumOfSquares);
         }
+        return;
     }
 
+    NEVESTRIP_PROFILE_BEGIN(stageProfiler, profile);
+    NEVESTRIP_TRACE_LAPS(traceLaps);
+
+    // === PREAMP SECTION ===
+
+    // Input gain with smoothing, phase inversion folded in; measures the input
+    applySmoothedGain(buffer, totalNumInputChannels, smoothInputGain, phaseInverted ? -1.0f : 1.0f,
+                      metering ? &inputLevel : nullptr, false);
+    STAGE_DONE(STAGE_INPUT);
+
     // High-pass filter
-    hpf.setFrequency(static_cast<int>(hpfFreq->load()));
     hpf.process(buffer);
+    STAGE_DONE(STAGE_HPF);
 
     // Transformer drive
-    transformer.setDrive(transformerDrive->load());
     transformer.process(buffer);
+    STAGE_DONE(STAGE_TRANSFORMER);
 
     // Apply output trim
-    for (int ch = 0; ch < totalNumInputChannels; ++ch)
-    {
-        float* data = buffer.getWritePointer(ch);
-        for (int i = 0; i < numSamples; ++i)
-        {
-            float trim = (ch == 0) ? smoothOutputTrim.getNextValue() : smoothOutputTrim.getCurrentValue();
-            data[i] *= trim;
-        }
-    }
+    applySmoothedGain(buffer, totalNumInputChannels, smoothOutputTrim, 1.0f, nullptr, false);
+    STAGE_DONE(STAGE_TRIM);
 
     // === EQ + DYNAMICS ===
 
-    // Update EQ parameters
-    eq.setBypass(eqBypass->load() > 0.5f);
-    eq.setHFFreq(static_cast<int>(hfFreq->load()));
-    eq.setHFGain(hfGain->load());
-    eq.setHMFreq(static_cast<int>(hmFreq->load()));
-    eq.setHMGain(hmGain->load());
-    eq.setLMFreq(static_cast<int>(lmFreq->load()));
-    eq.setLMGain(lmGain->load());
-    eq.setLFFreq(static_cast<int>(lfFreq->load()));
-    eq.setLFGain(lfGain->load());
-
-    // Update compressor parameters
-    compressor.setBypass(compBypass->load() > 0.5f);
-    compressor.setThreshold(compThreshold->load());
-    compressor.setRatio(static_cast<int>(compRatio->load()));
-    compressor.setAttack(static_cast<int>(compAttack->load()));
-    compressor.setRelease(static_cast<int>(compRelease->load()));
-    compressor.setMakeup(compMakeup->load());
-    compressor.setSidechainHPF(compSCHPF->load() > 0.5f);
-    compressor.setStereoLink(compLink->load() > 0.5f);
-
-    // Update limiter parameters
-    limiter.setBypass(limBypass->load() > 0.5f);
-    limiter.setThreshold(limThreshold->load());
-
     // EQ Pre/Post routing
-    bool eqPost = eqPrePost->load() > 0.5f;
-
     if (!eqPost)
     {
         // EQ before dynamics (Pre)
         eq.process(buffer);
+        STAGE_DONE(STAGE_EQ);
         compressor.process(buffer);
+        STAGE_DONE(STAGE_COMPRESSOR);
         limiter.process(buffer);
+        STAGE_DONE(STAGE_LIMITER);
     }
     else
     {
         // EQ after dynamics (Post)
         compressor.process(buffer);
+        STAGE_DONE(STAGE_COMPRESSOR);
         limiter.process(buffer);
+        STAGE_DONE(STAGE_LIMITER);
         eq.process(buffer);
+        STAGE_DONE(STAGE_EQ);
     }
 
     // === OUTPUT SECTION ===
 
-    float targetOutput = DSPUtils::decibelsToLinear(outputLevel->load());
-    smoothOutputLevel.setTargetValue(targetOutput);
+    // Output level with smoothing; measures the output
+    applySmoothedGain(buffer, totalNumInputChannels, smoothOutputLevel, 1.0f,
+                      metering ? &outputLevel : nullptr, true);
+
+    if (metering)
+        pushMeterFrame(numSamples, totalNumInputChannels, inputLevel.peak, inputLevel.sumOfSquares,
+                       outputLevel.peak, outputLevel.sumOfSquares);
+
+    pushAnalysisSamples(buffer, totalNumInputChannels);
+    STAGE_DONE(STAGE_OUTPUT);
+    NEVESTRIP_PROFILE_END(stageProfiler, profile, numSamples);
 
-    for (int ch = 0; ch < totalNumInputChannels; ++ch)
+    // Offline renders have no message thread to keep up with them
+    if (isNonRealtime())
+        drainAnalysisSamples();
+}
+
+void NeveStripAudioProcessor::pushMeterFrame(int numSamples, int numChannels, float inputPeak,
+                                             float inputSumOfSquares, float outputPeak, float outputSumOfSquares)
+{
+    if (numSamples == 0 || numChannels == 0)
+        return;
+
+    const float normalise = 1.0f / static_cast<float>(numSamples * numChannels);
+
+    MeterFrame frame;
+    frame.numSamples = numSamples;
+    frame.inputPeak = inputPeak;
+    frame.inputMeanSquare = inputSumOfSquares * normalise;
+    frame.outputPeak = outputPeak;
+    frame.outputMeanSquare = outputSumOfSquares * normalise;
+
+    if (! masterBypassed)
     {
-        float* data = buffer.getWritePointer(ch);
-        for (int i = 0; i < numSamples; ++i)
+        frame.compressorGR = compressor.getGainReductionStats();
+        frame.limiterGR = limiter.getGainReductionStats();
+    }
+
+    // A full ring (UI stalled) drops the frame
+    meterFrames.push(frame);
+
+    inputLevelMeter.store(inputPeak);
+    outputLevelMeter.store(outputPeak);
+}
+
+void NeveStripAudioProcessor::pushAnalysisSamples(const juce::AudioBuffer<float>& buffer, int numChannels)
+{
+    if (numChannels == 0)
+        return;
+
+    analysisChannels.store(juce::jmin(numChannels, 2), std::memory_order_relaxed);
+
+    const int numSamples = buffer.getNumSamples();
+
+    // Overflowed: drop whole blocks until the drain has caught up
+    if (analysisOverflowed.load(std::memory_order_acquire))
+    {
+        droppedAnalysisSamples.fetch_add(numSamples, std::memory_order_relaxed);
+        return;
+    }
+
+    int start1, size1, start2, size2;
+    analysisFifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+
+    if (size1 + size2 < numSamples)
+    {
+        droppedAnalysisSamples.fetch_add(numSamples, std::memory_order_relaxed);
+        analysisOverflowed.store(true, std::memory_order_release);
+        return;
+    }
+
+    for (int ch = 0; ch < juce::jmin(numChannels, 2); ++ch)
+    {
+        if (size1 > 0)
+            analysisBuffer.copyFrom(ch, start1, buffer, ch, 0, size1);
+        if (size2 > 0)
+            analysisBuffer.copyFrom(ch, start2, buffer, ch, size1, size2);
+    }
+
+    analysisFifo.finishedWrite(size1 + size2);
+}
+
+void NeveStripAudioProcessor::drainAnalysisSamples()
+{
+    NEVESTRIP_TRACE_SCOPE("drainAnalysisSamples");
+    const juce::ScopedLock sl(analysisLock);
+
+    // Not prepared yet
+    if (analysisBuffer.getNumChannels() < 2)
+        return;
+
+    const bool stereo = analysisChannels.load(std::memory_order_relaxed) > 1;
+    const float* left = analysisBuffer.getReadPointer(0);
+    const float* right = analysisBuffer.getReadPointer(1);
+
+    // Read before the FIFO: when set, everything written before the gap is
+    // ready below, and nothing after it until the flag is cleared
+    const bool gapAfter = analysisOverflowed.load(std::memory_order_acquire);
+
+    int start1, size1, start2, size2;
+    analysisFifo.prepareToRead(analysisFifo.getNumReady(), start1, size1, start2, size2);
+
+    if (size1 > 0)
+        loudnessMeter.process(left + start1, stereo ? right + start1 : nullptr, size1);
+    if (size2 > 0)
+        loudnessMeter.process(left + start2, stereo ? right + start2 : nullptr, size2);
+
+    // True peak: skipped entirely without subscribers; restarts from silence
+    const bool truePeakWanted = truePeakSubscribers.load(std::memory_order_relaxed) > 0;
+
+    if (truePeakWanted && ! truePeakRunning)
+    {
+        outputTruePeak[0].reset();
+        outputTruePeak[1].reset();
+        outputTruePeakMax.store(0.0f);
+    }
+    truePeakRunning = truePeakWanted;
+
+    if (truePeakWanted && size1 + size2 > 0)
+    {
+        float peak = 0.0f;
+
+        for (int ch = 0; ch < (stereo ? 2 : 1); ++ch)
         {
-            float outGain = (ch == 0) ? smoothOutputLevel.getNextValue() : smoothOutputLevel.getCurrentValue();
-            data[i] *= outGain;
+            const float* data = analysisBuffer.getReadPointer(ch);
+            peak = juce::jmax(peak, outputTruePeak[ch].processBlockPeak(data + start1, size1));
+            if (size2 > 0)
+                peak = juce::jmax(peak, outputTruePeak[ch].processBlockPeak(data + start2, size2));
         }
+
+        outputTruePeakMeter.store(peak);
+
+        // Held maximum; a reset from another thread may land in between
+        float held = outputTruePeakMax.load();
+        while (peak > held && ! outputTruePeakMax.compare_exchange_weak(held, peak)) {}
     }
 
-    // Measure output level
-    float outLevel = 0.0f;
-    for (int ch = 0; ch < totalNumInputChannels; ++ch)
-        outLevel = std::max(outLevel, buffer.getMagnitude(ch, 0, numSamples));
-    outputLevelMeter.store(outLevel);
+    // Interpolating across the gap would invent inter-sample peaks
+    if (gapAfter)
+    {
+        outputTruePeak[0].reset();
+        outputTruePeak[1].reset();
+    }
+
+    analysisFifo.finishedRead(size1 + size2);
+
+    if (gapAfter)
+        analysisOverflowed.store(false, std::memory_order_release);
 }
 
 void NeveStripAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
@@ -375,6 +851,31 @@ void NeveStripAudioProcessor::setStateInformation(const void* data, int sizeInBy
         apvts.replaceState(juce::ValueTree::fromXml(*xml));
 }
 
+bool NeveStripAudioProcessor::writeDeadlineReport(const juce::File& file) const
+{
+    const double sampleRate = getSampleRate();
+    const juce::PluginHostType host;
+
+    juce::String report;
+    report << JucePlugin_Name << " " << JucePlugin_VersionString << " callback timing report\n"
+           << "written: " << juce::Time::getCurrentTime().toISO8601(true) << "\n"
+           << "host: " << host.getHostDescription() << " ("
+           << juce::AudioProcessor::getWrapperTypeDescription(wrapperType) << ")\n"
+           << "system: " << juce::SystemStats::getOperatingSystemName() << ", "
+           << juce::SystemStats::getCpuModel() << "\n"
+           << "sample rate: " << sampleRate << " Hz, block size: " << preparedBlockSize
+           << " (deadline " << juce::String(sampleRate > 0.0 ? 1000.0 * preparedBlockSize / sampleRate : 0.0, 3)
+           << " ms), channels: " << getTotalNumInputChannels() << ", latency: " << getLatencySamples() << "\n"
+           << "\n" << deadlineMonitor.formatReport()
+           << "\nparameters:\n";
+
+    for (auto* id : parameterIDs)
+        if (auto* value = apvts.getRawParameterValue(id))
+            report << "  " << id << " = " << value->load() << "\n";
+
+    return file.replaceWithText(report);
+}
+
 juce::AudioProcessorEditor* NeveStripAudioProcessor::createEditor()
 {
     return new NeveStripAudioProcessorEditor(*this);
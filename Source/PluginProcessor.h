@@ -6,8 +6,18 @@
 #include "DSP/NeveEQ.h"
 #include "DSP/NeveCompressor.h"
 #include "DSP/NeveLimiter.h"
+#include "DSP/LoudnessMeter.h"
+#include "DSP/TruePeakDetector.h"
+#include "DSP/FrameQueue.h"
+#include "Instrumentation/StageProfiler.h"
+#include "Instrumentation/DeadlineMonitor.h"
+#include "Instrumentation/TraceRecorder.h"
+#include "Instrumentation/RealtimeGuard.h"
 
-class NeveStripAudioProcessor : public juce::AudioProcessor
+class NeveStripAudioProcessor : public juce::AudioProcessor,
+                                private juce::AudioProcessorValueTreeState::Listener,
+                                private juce::AsyncUpdater,
+                                private juce::Timer
 {
 public:
     NeveStripAudioProcessor();
@@ -42,16 +52,174 @@ public:
 
     juce::AudioProcessorValueTreeState& getAPVTS() { return apvts; }
 
-    // Metering
+    // Metering: one frame per block, measured in the gain passes. Frames
+    // (and the two block peaks below) are only produced while a consumer is
+    // subscribed; popMeterFrame() is for that one consumer thread.
+    struct MeterFrame
+    {
+        int numSamples = 0;
+        float inputPeak = 0.0f;              // Linear, largest over the channels
+        float inputMeanSquare = 0.0f;        // Averaged over the channels
+        float outputPeak = 0.0f;
+        float outputMeanSquare = 0.0f;
+        GainReductionStats compressorGR;
+        GainReductionStats limiterGR;
+    };
+
+    void subscribeMeterFrames() { ++meterSubscribers; }
+    void unsubscribeMeterFrames() { --meterSubscribers; }
+    bool popMeterFrame(MeterFrame& frame) { return meterFrames.pop(frame); }
+
     float getInputLevel() const { return inputLevelMeter.load(); }
     float getOutputLevel() const { return outputLevelMeter.load(); }
+
+    // Output true peak (linear, 4x interpolated) of everything drained since
+    // the previous drain, and the largest since resetTruePeakMax() or since
+    // measuring last started; only measured while a consumer is subscribed
+    float getOutputTruePeak() const { return outputTruePeakMeter.load(); }
+    float getOutputTruePeakMax() const { return outputTruePeakMax.load(); }
+    void resetTruePeakMax() { outputTruePeakMax.store(0.0f); }
+    void subscribeTruePeak() { ++truePeakSubscribers; }
+    void unsubscribeTruePeak() { --truePeakSubscribers; }
+
+    // Gain reduction of the last block (dB), any thread
     float getCompressorGR() const { return compressor.getGainReduction(); }
     float getLimiterGR() const { return limiter.getGainReduction(); }
+    GainReductionStats getCompressorGRStats() const { return compressor.getGainReductionStats(); }
+    GainReductionStats getLimiterGRStats() const { return limiter.getGainReductionStats(); }
+
+    // Output loudness (BS.1770), LUFS / LU
+    float getMomentaryLoudness() const { return loudnessMeter.getMomentary(); }
+    float getShortTermLoudness() const { return loudnessMeter.getShortTerm(); }
+    float getIntegratedLoudness() const { return loudnessMeter.getIntegrated(); }
+    float getLoudnessRange() const { return loudnessMeter.getLoudnessRange(); }
+    void resetLoudness()
+    {
+        loudnessMeter.requestReset();
+        droppedAtLoudnessStart.store(droppedAnalysisSamples.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    // Output samples the analysis never saw (message thread stalled) since
+    // the loudness measurement last started; while non-zero, integrated
+    // loudness and range are missing that audio
+    juce::int64 getDroppedAnalysisSamples() const
+    {
+        return droppedAnalysisSamples.load(std::memory_order_relaxed) - droppedAtLoudnessStart.load(std::memory_order_relaxed);
+    }
+
+    // Per-stage CPU profile of processBlock (ns per sample), in chain order
+    // as measured; all zero unless built with NEVESTRIP_PROFILING
+    enum ProcessingStage
+    {
+        STAGE_INPUT = 0,          // Input gain and phase (one pass)
+        STAGE_HPF, STAGE_TRANSFORMER, STAGE_TRIM,
+        STAGE_EQ, STAGE_COMPRESSOR, STAGE_LIMITER,
+        STAGE_OUTPUT,             // Output level, meter frame, analysis FIFO
+        NUM_STAGES
+    };
+
+    using StageStats = StageProfiler<NUM_STAGES>::Stats;
+    static const char* const stageNames[NUM_STAGES];
+    static constexpr bool isProfilingEnabled() { return NEVESTRIP_PROFILING != 0; }
+
+   #if NEVESTRIP_PROFILING
+    StageStats getStageStats(int stage) const { return stageProfiler.getStats(stage); }
+    void resetStageStats() { stageProfiler.requestReset(); }
+   #else
+    StageStats getStageStats(int) const { return {}; }
+    void resetStageStats() {}
+   #endif
+
+    // Callback time against the block deadline, realtime callbacks only
+    DeadlineMonitor::Stats getDeadlineStats() const { return deadlineMonitor.getStats(); }
+    void resetDeadlineStats() { deadlineMonitor.requestReset(); }
+
+    // Timing report plus the host, configuration and parameter values it
+    // was measured with; message thread
+    bool writeDeadlineReport(const juce::File& file) const;
 
 private:
     juce::AudioProcessorValueTreeState apvts;
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+    // One bit per parameter in pendingParameterChanges
+    enum ParameterIndex
+    {
+        PARAM_INPUT_GAIN = 0, PARAM_OUTPUT_TRIM, PARAM_PHASE, PARAM_HPF_FREQ,
+        PARAM_HF_FREQ, PARAM_HF_GAIN, PARAM_HM_FREQ, PARAM_HM_GAIN,
+        PARAM_LM_FREQ, PARAM_LM_GAIN, PARAM_LF_FREQ, PARAM_LF_GAIN,
+        PARAM_EQ_BYPASS, PARAM_EQ_PRE_POST,
+        PARAM_COMP_THRESHOLD, PARAM_COMP_RATIO, PARAM_COMP_ATTACK, PARAM_COMP_RELEASE,
+        PARAM_COMP_MAKEUP, PARAM_COMP_SC_HPF, PARAM_COMP_LINK, PARAM_COMP_BYPASS, PARAM_COMP_CONTROL_RATE,
+        PARAM_LIM_THRESHOLD, PARAM_LIM_BYPASS, PARAM_LIM_MODE,
+        PARAM_TRANSFORMER_DRIVE, PARAM_TRANSFORMER_QUALITY,
+        PARAM_OS_FACTOR, PARAM_OS_MODE, PARAM_TRANSFORMER_AA,
+        PARAM_OUTPUT_LEVEL, PARAM_MASTER_BYPASS,
+        NUM_PARAMETERS
+    };
+
+    static_assert(NUM_PARAMETERS <= 64, "Parameter change mask is 64 bits wide");
+
+    static const char* const parameterIDs[NUM_PARAMETERS];
+    static constexpr uint64_t allParametersChanged = (uint64_t(1) << NUM_PARAMETERS) - 1;
+
+    // Compressor, limiter, transformer and anti-aliasing parameters need
+    // coefficient maths, table builds or a latency change, so they are
+    // applied off the audio thread and reach the audio thread as snapshots
+    static constexpr uint64_t parameterBits(int first, int last)
+    {
+        return ((uint64_t(1) << (last + 1)) - 1) & ~((uint64_t(1) << first) - 1);
+    }
+    static constexpr uint64_t offThreadParameters = parameterBits(PARAM_COMP_THRESHOLD, PARAM_TRANSFORMER_AA);
+
+    // Parameter change delivery: the listener (any thread) sets one bit per
+    // changed parameter. The audio thread drains its mask once per block and
+    // only touches the modules whose parameters moved; off-thread parameters
+    // go to a second mask polled by the module parameter service
+    void parameterChanged(const juce::String& parameterID, float newValue) override;
+    void applyParameterChanges(uint64_t changes);
+
+    // Parameter service, prepareToPlay and offline blocks; true if the latency may have changed
+    bool applyPendingModuleChanges();
+    bool applyModuleParameterChanges(uint64_t changes);
+
+    // Latency changes are reported to the host from the message thread
+    void handleAsyncUpdate() override;
+
+    // Oversampling + transformer ADAA + limiter lookahead; takes moduleParameterLock
+    void updateLatency();
+
+    std::atomic<uint64_t> pendingParameterChanges { allParametersChanged & ~offThreadParameters };
+    std::atomic<uint64_t> pendingModuleChanges { offThreadParameters };
+
+    // Serialises module setters between the service, prepareToPlay and offline rendering
+    juce::CriticalSection moduleParameterLock;
+
+    // One thread for every instance in the process: polls each registered
+    // instance's module mask every couple of milliseconds, so host automation
+    // lands within a block or two without the message thread, and
+    // parameterChanged() only sets a bit - nothing wakes or locks from the
+    // audio thread
+    class ModuleParameterService : private juce::Thread
+    {
+    public:
+        ModuleParameterService();
+        ~ModuleParameterService() override;
+
+        void add(NeveStripAudioProcessor& processor);
+        void remove(NeveStripAudioProcessor& processor);
+
+    private:
+        static constexpr int pollIntervalMs = 2;
+
+        void run() override;
+
+        juce::CriticalSection instancesLock;     // Polling vs. instances coming and going
+        juce::Array<NeveStripAudioProcessor*> instances;
+    };
+
+    juce::SharedResourcePointer<ModuleParameterService> moduleParameterService;
+
     // DSP Modules
     Transformer transformer;
     HighPassFilter hpf;
@@ -65,6 +233,7 @@ private:
     std::atomic<float>* phase = nullptr;
     std::atomic<float>* hpfFreq = nullptr;
     std::atomic<float>* transformerDrive = nullptr;
+    std::atomic<float>* transformerQuality = nullptr;
 
     // === EQ SECTION ===
     std::atomic<float>* hfFreq = nullptr;
@@ -87,18 +256,67 @@ private:
     std::atomic<float>* compSCHPF = nullptr;
     std::atomic<float>* compLink = nullptr;
     std::atomic<float>* compBypass = nullptr;
+    std::atomic<float>* compControlRate = nullptr;
 
     std::atomic<float>* limThreshold = nullptr;
     std::atomic<float>* limBypass = nullptr;
+    std::atomic<float>* limMode = nullptr;
+
+    // === OVERSAMPLING ===
+    std::atomic<float>* osFactor = nullptr;
+    std::atomic<float>* osMode = nullptr;
+    std::atomic<float>* transformerAA = nullptr;
 
     // === OUTPUT ===
     std::atomic<float>* outputLevel = nullptr;
     std::atomic<float>* masterBypass = nullptr;
 
+    // Audio-thread copies of switch parameters (updated from the change mask)
+    bool phaseInverted = false;
+    bool eqPost = false;
+    bool masterBypassed = false;
+
     // Metering
+    void pushMeterFrame(int numSamples, int numChannels, float inputPeak, float inputSumOfSquares,
+                        float outputPeak, float outputSumOfSquares);
+
+    std::atomic<int> meterSubscribers { 0 };
+    FrameQueue<MeterFrame, 1024> meterFrames;
     std::atomic<float> inputLevelMeter { 0.0f };
     std::atomic<float> outputLevelMeter { 0.0f };
 
+    // Output analysis (loudness, true peak): the audio thread only copies
+    // the output into a FIFO; it is drained on the message thread (timer),
+    // or inline when rendering offline. A stalled message thread drops
+    // samples rather than blocking the audio thread: once a block doesn't
+    // fit, nothing more is written until the drain has emptied the FIFO, so
+    // the gap sits exactly after what that drain reads. Dropped samples are
+    // counted, and the true-peak history restarts after the gap.
+    void pushAnalysisSamples(const juce::AudioBuffer<float>& buffer, int numChannels);
+    void drainAnalysisSamples();
+    void timerCallback() override { drainAnalysisSamples(); }
+
+    LoudnessMeter loudnessMeter;
+    TruePeakDetector outputTruePeak[2];
+    std::atomic<int> truePeakSubscribers { 0 };
+    bool truePeakRunning = false;            // Drain side: detectors hold live history
+    std::atomic<float> outputTruePeakMeter { 0.0f };
+    std::atomic<float> outputTruePeakMax { 0.0f };
+    juce::AbstractFifo analysisFifo { 1 };
+    juce::AudioBuffer<float> analysisBuffer;
+    std::atomic<int> analysisChannels { 2 };
+    std::atomic<bool> analysisOverflowed { false };            // Set by the audio thread, cleared by the drain
+    std::atomic<juce::int64> droppedAnalysisSamples { 0 };     // Running total
+    std::atomic<juce::int64> droppedAtLoudnessStart { 0 };
+    juce::CriticalSection analysisLock;      // Timer vs. offline drains
+
+   #if NEVESTRIP_PROFILING
+    StageProfiler<NUM_STAGES> stageProfiler;
+   #endif
+
+    DeadlineMonitor deadlineMonitor;
+    int preparedBlockSize = 0;
+
     // Smoothed parameters
     juce::SmoothedValue<float> smoothInputGain;
     juce::SmoothedValue<float> smoothOutputTrim;
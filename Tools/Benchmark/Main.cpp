@@ -0,0 +1,334 @@
+/*
+ * NeveStripBenchmark - per-module microbenchmarks for Source/DSP
+ *
+ * Times process() of Transformer, HighPassFilter, NeveEQ, NeveCompressor
+ * and NeveLimiter on their own, for each representative setting, block
+ * size (16 to 4096), sample rate (44.1 to 192 kHz) and channel count. The
+ * limiter also runs as the frozen scalar reference (Tools/Equivalence), so
+ * the speed-up of its classic path is measured in the same run.
+ *
+ * Each case is prepared, run for a second of audio to settle, then timed
+ * over runs of at least --min-ms; the median run is reported. The input
+ * is copied into the block before every process() call (as a host would
+ * hand over fresh audio), so the figures include one buffer copy.
+ *
+ * Output is JSON (stdout, or --output file):
+ *   { "benchmark": ..., "results": [ { "module", "setting", "sampleRate",
+ *     "blockSize", "channels", "nsPerSample", "realtimeFactor" }, ... ] }
+ * nsPerSample is per sample frame (all channels); realtimeFactor is audio
+ * time over processing time.
+ *
+ * Usage: NeveStripBenchmark [--quick] [--module=Name] [--min-ms=N] [--output=file]
+ *   --quick  44.1/96 kHz and blocks of 64/512 only
+ */
+
+#include <JuceHeader.h>
+#include "Transformer.h"
+#include "HighPassFilter.h"
+#include "NeveEQ.h"
+#include "NeveCompressor.h"
+#include "NeveLimiter.h"
+#include "Reference/NeveLimiter.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// Type-erased module under test
+struct Subject
+{
+    std::function<void(double sampleRate, int blockSize)> prepare;
+    std::function<void(juce::AudioBuffer<float>&)> process;
+};
+
+struct Case
+{
+    const char* module;
+    const char* setting;
+    float inputGain;                              // Linear, applied to the test signal
+    std::function<Subject()> create;
+};
+
+// Wraps a module; configure() runs before and after prepare(), as the
+// processor applies parameters after prepareToPlay
+template <typename Module>
+static Subject makeSubject(std::function<void(Module&)> configure)
+{
+    auto module = std::make_shared<Module>();
+
+    return {
+        [module, configure](double sampleRate, int blockSize)
+        {
+            configure(*module);
+            module->prepare(sampleRate, blockSize);
+            configure(*module);
+        },
+        [module](juce::AudioBuffer<float>& buffer) { module->process(buffer); }
+    };
+}
+
+static std::vector<Case> makeCases()
+{
+    std::vector<Case> cases;
+
+    auto add = [&cases](const char* module, const char* setting, float gain, std::function<Subject()> create)
+    {
+        cases.push_back({ module, setting, gain, std::move(create) });
+    };
+
+    // === TRANSFORMER ===
+    auto transformer = [](float drive, Transformer::Quality quality, int stages, ADAATanh::Order aa)
+    {
+        return [=]
+        {
+            return makeSubject<Transformer>([=](Transformer& t)
+            {
+                t.setDrive(drive);
+                t.setQuality(quality);
+                t.setOversampling(stages, Oversampler::MODE_IIR);
+                t.setAntiAliasing(aa);
+            });
+        };
+    };
+
+    add("Transformer", "drive 50, cubic table", 0.5f, transformer(50.0f, Transformer::QUALITY_CUBIC, 0, ADAATanh::ORDER_NONE));
+    add("Transformer", "drive 50, analytic", 0.5f, transformer(50.0f, Transformer::QUALITY_ANALYTIC, 0, ADAATanh::ORDER_NONE));
+    add("Transformer", "drive 100, ADAA 1st order", 0.5f, transformer(100.0f, Transformer::QUALITY_CUBIC, 0, ADAATanh::ORDER_1));
+    add("Transformer", "drive 100, 4x IIR", 0.5f, transformer(100.0f, Transformer::QUALITY_CUBIC, 2, ADAATanh::ORDER_NONE));
+
+    // === HIGH-PASS FILTER ===
+    auto hpf = [](int frequency)
+    {
+        return [=] { return makeSubject<HighPassFilter>([=](HighPassFilter& f) { f.setFrequency(frequency); }); };
+    };
+
+    add("HighPassFilter", "off", 0.5f, hpf(HighPassFilter::HPF_OFF));
+    add("HighPassFilter", "80 Hz", 0.5f, hpf(HighPassFilter::HPF_80Hz));
+
+    // === EQ ===
+    auto eq = [](float gainDb)
+    {
+        return [=]
+        {
+            return makeSubject<NeveEQ>([=](NeveEQ& e)
+            {
+                e.setHFFreq(NeveEQ::HF_12K);  e.setHFGain(gainDb);
+                e.setHMFreq(NeveEQ::HM_3K2);  e.setHMGain(-gainDb);
+                e.setLMFreq(NeveEQ::LM_360);  e.setLMGain(gainDb);
+                e.setLFFreq(NeveEQ::LF_60);   e.setLFGain(-gainDb);
+            });
+        };
+    };
+
+    add("NeveEQ", "bands off", 0.5f, eq(0.0f));
+    add("NeveEQ", "all bands on", 0.5f, eq(6.0f));
+
+    // === COMPRESSOR ===
+    auto compressor = [](bool link, int release, bool controlRate)
+    {
+        return [=]
+        {
+            return makeSubject<NeveCompressor>([=](NeveCompressor& c)
+            {
+                c.setBypass(false);
+                c.setThreshold(-20.0f);
+                c.setRatio(NeveCompressor::RATIO_4);
+                c.setAttack(NeveCompressor::ATTACK_FAST);
+                c.setRelease(release);
+                c.setMakeup(6.0f);
+                c.setSidechainHPF(true);
+                c.setStereoLink(link);
+                c.setControlRate(controlRate);
+            });
+        };
+    };
+
+    add("NeveCompressor", "link on, medium release", 0.7f, compressor(true, NeveCompressor::RELEASE_MED, false));
+    add("NeveCompressor", "link off, medium release", 0.7f, compressor(false, NeveCompressor::RELEASE_MED, false));
+    add("NeveCompressor", "link on, auto release", 0.7f, compressor(true, NeveCompressor::RELEASE_AUTO, false));
+    add("NeveCompressor", "link on, control rate", 0.7f, compressor(true, NeveCompressor::RELEASE_MED, true));
+
+    // === LIMITER ===
+    auto limiter = [](bool lookahead, int stages)
+    {
+        return [=]
+        {
+            return makeSubject<NeveLimiter>([=](NeveLimiter& l)
+            {
+                l.setBypass(false);
+                l.setThreshold(-12.0f);
+                l.setLookahead(lookahead);
+                l.setOversampling(stages, Oversampler::MODE_IIR);
+            });
+        };
+    };
+
+    // Heavy limiting: peaks around +4 dBFS into a -12 dB threshold
+    add("NeveLimiter", "heavy, classic", 2.0f, limiter(false, 0));
+    add("NeveLimiter", "heavy, lookahead true peak", 2.0f, limiter(true, 0));
+    add("NeveLimiter", "heavy, classic 4x IIR", 2.0f, limiter(false, 2));
+
+    // The same classic settings on the scalar code the live limiter replaced
+    add("NeveLimiter", "heavy, reference", 2.0f, []
+    {
+        return makeSubject<Reference::NeveLimiter>([](Reference::NeveLimiter& l)
+        {
+            l.setBypass(false);
+            l.setThreshold(-12.0f);
+        });
+    });
+
+    return cases;
+}
+
+// One second of programme-like test signal: two tones, a slow level swell and noise
+static juce::AudioBuffer<float> makeSignal(double sampleRate, float gain)
+{
+    const int length = static_cast<int>(sampleRate);
+    juce::AudioBuffer<float> signal(2, length);
+    juce::Random random(42);
+
+    for (int ch = 0; ch < 2; ++ch)
+    {
+        auto* data = signal.getWritePointer(ch);
+        for (int i = 0; i < length; ++i)
+        {
+            const double t = static_cast<double>(i) / sampleRate;
+            const double swell = 0.6 + 0.4 * std::sin(juce::MathConstants<double>::twoPi * 2.0 * t);
+            const double tones = 0.5 * std::sin(juce::MathConstants<double>::twoPi * (110.0 + ch) * t)
+                               + 0.3 * std::sin(juce::MathConstants<double>::twoPi * 3300.0 * t);
+            data[i] = gain * static_cast<float>(swell * tones) + 0.02f * gain * (random.nextFloat() - 0.5f);
+        }
+    }
+
+    return signal;
+}
+
+struct Measurement
+{
+    double nsPerSample = 0.0;
+    double realtimeFactor = 0.0;
+};
+
+static Measurement measure(const Case& c, double sampleRate, int blockSize, int channels, double minSeconds)
+{
+    juce::ScopedNoDenormals noDenormals;
+
+    Subject subject = c.create();
+    subject.prepare(sampleRate, blockSize);
+
+    const juce::AudioBuffer<float> signal = makeSignal(sampleRate, c.inputGain);
+    juce::AudioBuffer<float> block(channels, blockSize);
+    int position = 0;
+
+    auto processOneBlock = [&]
+    {
+        if (position + blockSize > signal.getNumSamples())
+            position = 0;
+
+        for (int ch = 0; ch < channels; ++ch)
+            block.copyFrom(ch, 0, signal, ch, position, blockSize);
+
+        subject.process(block);
+        position += blockSize;
+    };
+
+    // Settle envelopes, smoothing and caches on a second of audio
+    for (int done = 0; done < signal.getNumSamples(); done += blockSize)
+        processOneBlock();
+
+    constexpr int numRuns = 5;
+    std::vector<double> nsPerSample;
+
+    for (int run = 0; run < numRuns; ++run)
+    {
+        int64_t samples = 0;
+        const auto start = std::chrono::steady_clock::now();
+        double elapsed = 0.0;
+
+        do
+        {
+            for (int i = 0; i < 16; ++i)
+                processOneBlock();
+
+            samples += 16 * blockSize;
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+        while (elapsed < minSeconds);
+
+        nsPerSample.push_back(elapsed * 1.0e9 / static_cast<double>(samples));
+    }
+
+    std::sort(nsPerSample.begin(), nsPerSample.end());
+
+    Measurement m;
+    m.nsPerSample = nsPerSample[numRuns / 2];
+    m.realtimeFactor = 1.0e9 / (m.nsPerSample * sampleRate);
+    return m;
+}
+
+int main(int argc, char* argv[])
+{
+    const juce::ArgumentList arguments(argc, argv);
+    const bool quick = arguments.containsOption("--quick");
+    const juce::String moduleFilter = arguments.getValueForOption("--module");
+    const juce::String outputPath = arguments.getValueForOption("--output");
+    const int minMs = arguments.getValueForOption("--min-ms").getIntValue();
+    const double minSeconds = (minMs > 0 ? minMs : 20) * 1.0e-3;
+
+    const std::vector<double> sampleRates = quick ? std::vector<double> { 44100.0, 96000.0 }
+                                                  : std::vector<double> { 44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0 };
+    const std::vector<int> blockSizes = quick ? std::vector<int> { 64, 512 }
+                                              : std::vector<int> { 16, 32, 64, 128, 256, 512, 1024, 2048, 4096 };
+
+    std::FILE* out = outputPath.isNotEmpty() ? std::fopen(outputPath.toRawUTF8(), "w") : stdout;
+    if (out == nullptr)
+    {
+        std::fprintf(stderr, "cannot write %s\n", outputPath.toRawUTF8());
+        return 1;
+    }
+
+    std::fprintf(out, "{\n  \"benchmark\": \"NeveStripBenchmark\",\n  \"version\": \"%s\",\n"
+                      "  \"minRunMs\": %.0f,\n  \"results\": [", NEVESTRIP_VERSION, minSeconds * 1.0e3);
+
+    bool first = true;
+
+    for (const auto& c : makeCases())
+    {
+        if (moduleFilter.isNotEmpty() && moduleFilter != c.module)
+            continue;
+
+        for (double sampleRate : sampleRates)
+        {
+            for (int blockSize : blockSizes)
+            {
+                for (int channels = 1; channels <= 2; ++channels)
+                {
+                    const Measurement m = measure(c, sampleRate, blockSize, channels, minSeconds);
+
+                    std::fprintf(out, "%s\n    { \"module\": \"%s\", \"setting\": \"%s\", \"sampleRate\": %.0f, "
+                                      "\"blockSize\": %d, \"channels\": %d, \"nsPerSample\": %.3f, \"realtimeFactor\": %.1f }",
+                                 first ? "" : ",", c.module, c.setting, sampleRate, blockSize, channels,
+                                 m.nsPerSample, m.realtimeFactor);
+                    std::fflush(out);
+                    first = false;
+
+                    if (out != stdout)
+                        std::fprintf(stderr, "%-15s %-28s %6.0f Hz %5d x%d  %8.2f ns/sample  %8.0fx realtime\n",
+                                     c.module, c.setting, sampleRate, blockSize, channels,
+                                     m.nsPerSample, m.realtimeFactor);
+                }
+            }
+        }
+    }
+
+    std::fprintf(out, "\n  ]\n}\n");
+
+    if (out != stdout)
+        std::fclose(out);
+
+    return 0;
+}
@@ -0,0 +1,886 @@
+/*
+ * NeveStripEquivalence - optimised DSP against the frozen scalar reference
+ *
+ * Tools/Equivalence/Reference holds the DSP modules as they were before the
+ * optimisation work (plain per-sample scalar code, only wrapped in namespace
+ * Reference). This runs each live module and its reference side by side on
+ * the same input and checks the live output stays within bounds:
+ *
+ * - max absolute error (linear, full scale = 1)
+ * - null depth: energy of the difference over energy of the reference, dB
+ * - spectral deviation: largest |dB| difference between the Welch power
+ *   spectra of the two outputs, over bins within 60 dB of the peak
+ * - gain deviation (gain stages only): largest per-sample |dB| ratio of the
+ *   two outputs, i.e. the difference in applied gain
+ * - THD deviation (shaper tables, ADAA): largest |dB| difference in total
+ *   harmonic distortion of a tone, at levels up to the case's input
+ * - alias change (ADAA only): level of the harmonics a 5 kHz tone folds
+ *   back below itself, live against reference, at the same levels
+ * - knee-edge flips (compressor against the reference only): samples whose
+ *   gain differs by the reference curve's step at the top of its knee are
+ *   counted, as a fraction of all samples, and left out of the other
+ *   metrics, so those can be bounded tightly
+ *
+ * Signals: a logarithmic sine sweep, white noise, and transients (impulses,
+ * tone bursts and DC steps on a quiet floor). Blocks are fed at irregular
+ * lengths so chunked and vectorised paths see their edges.
+ *
+ * Cases step every setting that has a reference counterpart: each HPF
+ * frequency; each EQ band at each frequency over the gain range (1 dB
+ * steps, the whole 0.1 dB grid with --exhaustive); transformer drive for
+ * every shaper quality; the compressor over ratio, attack, release, link and
+ * sidechain HPF, sample-rate and control-rate gain computer; the classic
+ * limiter over its threshold. The control-rate compressor is also checked
+ * against the live per-sample one for its 0.1 dB gain bound, and the
+ * transformer's shaper tables against its analytic curve for THD, with the
+ * shaper input spanning the whole table. ADAA is checked against the plain
+ * analytic curve on tones only: THD of a 100 Hz tone, where it must match,
+ * and the aliases of a 5 kHz one, which it must lower. Its half-sample
+ * delay and top-octave roll-off rule out sample-wise comparison.
+ * Oversampling and the lookahead limiter have no scalar counterpart and are
+ * not covered.
+ *
+ * The bounds per fast path are in makeCases(); the summary gives the worst
+ * figures seen per path, i.e. what that path gives up against the reference.
+ *
+ * Usage: NeveStripEquivalence [--exhaustive] [--module=Name] [--verbose] [--output=file.json]
+ *
+ * Exit status is 1 if any case is out of bounds.
+ */
+
+#include <JuceHeader.h>
+#include "Transformer.h"
+#include "HighPassFilter.h"
+#include "NeveEQ.h"
+#include "NeveCompressor.h"
+#include "NeveLimiter.h"
+#include "Reference/Transformer.h"
+#include "Reference/HighPassFilter.h"
+#include "Reference/NeveEQ.h"
+#include "Reference/NeveCompressor.h"
+#include "Reference/NeveLimiter.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct Bounds
+{
+    double maxAbsError;                           // Linear
+    double nullDepthDb;                           // Difference at least this far below the reference
+    double spectralDeviationDb;
+    double gainDeviationDb = 0.0;                 // 0: not checked
+    double thdDeviationDb = 0.0;                  // 0: not checked
+    double kneeFlips = 0.0;                       // Fraction of samples; 0: not checked
+    double aliasChangeDb = 0.0;                   // Live aliases at least this far below; 0: not checked,
+                                                  // otherwise the case runs tone tests only
+};
+
+struct Metrics
+{
+    double maxAbsError = 0.0;
+    double nullDepthDb = -200.0;
+    double spectralDeviationDb = 0.0;
+    double gainDeviationDb = 0.0;
+    double thdDeviationDb = 0.0;
+    double kneeFlips = 0.0;
+    double aliasChangeDb = -200.0;
+
+    void takeWorst(const Metrics& other)
+    {
+        maxAbsError = std::max(maxAbsError, other.maxAbsError);
+        nullDepthDb = std::max(nullDepthDb, other.nullDepthDb);
+        spectralDeviationDb = std::max(spectralDeviationDb, other.spectralDeviationDb);
+        gainDeviationDb = std::max(gainDeviationDb, other.gainDeviationDb);
+        thdDeviationDb = std::max(thdDeviationDb, other.thdDeviationDb);
+        kneeFlips = std::max(kneeFlips, other.kneeFlips);
+        aliasChangeDb = std::max(aliasChangeDb, other.aliasChangeDb);
+    }
+
+    bool within(const Bounds& b) const
+    {
+        return maxAbsError <= b.maxAbsError && nullDepthDb <= b.nullDepthDb && spectralDeviationDb <= b.spectralDeviationDb
+            && (b.gainDeviationDb <= 0.0 || gainDeviationDb <= b.gainDeviationDb)
+            && (b.thdDeviationDb <= 0.0 || thdDeviationDb <= b.thdDeviationDb)
+            && (b.kneeFlips <= 0.0 || kneeFlips <= b.kneeFlips)
+            && (b.aliasChangeDb >= 0.0 || aliasChangeDb <= b.aliasChangeDb);
+    }
+};
+
+// A live module and its reference, configured identically
+struct Pair
+{
+    std::function<void(double sampleRate, int blockSize)> prepare;
+    std::function<void(juce::AudioBuffer<float>&)> processReference;
+    std::function<void(juce::AudioBuffer<float>&)> processLive;
+};
+
+struct Case
+{
+    const char* module;
+    const char* path;                             // The fast path under test; bounds are per path
+    std::string setting;
+    float inputGain;                              // Linear, applied to the test signals
+    Bounds bounds;
+    std::function<Pair()> create;
+    double kneeStepDb = 0.0;                      // Gain step of samples to mask as knee-edge flips; 0: none
+    double toneHz = 1000.0;                       // THD test tone
+};
+
+// configure() sets what both versions share; configureLive() selects the
+// live fast path. Both run before and after prepare(), as in the processor.
+template <typename ReferenceModule, typename LiveModule, typename Configure>
+static Pair makePair(Configure configure, std::function<void(LiveModule&)> configureLive)
+{
+    auto reference = std::make_shared<ReferenceModule>();
+    auto live = std::make_shared<LiveModule>();
+
+    return {
+        [=](double sampleRate, int blockSize)
+        {
+            configure(*reference);
+            reference->prepare(sampleRate, blockSize);
+            configure(*reference);
+
+            configure(*live);
+            configureLive(*live);
+            live->prepare(sampleRate, blockSize);
+            configure(*live);
+            configureLive(*live);
+        },
+        [reference](juce::AudioBuffer<float>& buffer) { reference->process(buffer); },
+        [live](juce::AudioBuffer<float>& buffer) { live->process(buffer); }
+    };
+}
+
+static std::string format(const char* pattern, double a, double b = 0.0, double c = 0.0, double d = 0.0, double e = 0.0)
+{
+    char text[128];
+    std::snprintf(text, sizeof(text), pattern, a, b, c, d, e);
+    return text;
+}
+
+static std::vector<Case> makeCases(bool exhaustive)
+{
+    std::vector<Case> cases;
+    const float gainStep = exhaustive ? 0.1f : 1.0f;
+
+    // === HIGH-PASS FILTER ===
+    // Same biquads; the live version only differs in evaluation order
+    const Bounds hpfBounds { 1.0e-5, -100.0, 0.01 };
+    const char* const hpfNames[] = { "off", "50 Hz", "80 Hz", "160 Hz", "300 Hz" };
+
+    for (int frequency = HighPassFilter::HPF_OFF; frequency <= HighPassFilter::HPF_300Hz; ++frequency)
+    {
+        cases.push_back({ "HighPassFilter", "biquad", hpfNames[frequency], 0.5f, hpfBounds, [=]
+        {
+            return makePair<Reference::HighPassFilter, HighPassFilter>(
+                [=](auto& f) { f.setFrequency(frequency); }, [](HighPassFilter&) {});
+        } });
+    }
+
+    // === EQ ===
+    // Coefficients from the precomputed tables, flat bands skipped
+    const Bounds eqBounds { 1.0e-4, -90.0, 0.01 };
+
+    struct Band
+    {
+        const char* name;
+        int numFrequencies;
+        float maxGainDb;
+        std::function<void(Reference::NeveEQ&, int, float)> setReference;
+        std::function<void(NeveEQ&, int, float)> setLive;
+    };
+
+    const Band bands[] =
+    {
+        { "HF", 3, 16.0f, [](Reference::NeveEQ& e, int f, float g) { e.setHFFreq(f); e.setHFGain(g); },
+                          [](NeveEQ& e, int f, float g) { e.setHFFreq(f); e.setHFGain(g); } },
+        { "HM", 5, 12.0f, [](Reference::NeveEQ& e, int f, float g) { e.setHMFreq(f); e.setHMGain(g); },
+                          [](NeveEQ& e, int f, float g) { e.setHMFreq(f); e.setHMGain(g); } },
+        { "LM", 5, 16.0f, [](Reference::NeveEQ& e, int f, float g) { e.setLMFreq(f); e.setLMGain(g); },
+                          [](NeveEQ& e, int f, float g) { e.setLMFreq(f); e.setLMGain(g); } },
+        { "LF", 4, 16.0f, [](Reference::NeveEQ& e, int f, float g) { e.setLFFreq(f); e.setLFGain(g); },
+                          [](NeveEQ& e, int f, float g) { e.setLFFreq(f); e.setLFGain(g); } },
+    };
+
+    for (const auto& band : bands)
+    {
+        const int steps = static_cast<int>(std::lround(band.maxGainDb / gainStep));
+
+        for (int frequency = 0; frequency < band.numFrequencies; ++frequency)
+        {
+            for (int step = -steps; step <= steps; ++step)
+            {
+                // On the 0.1 dB grid, so the live quantisation picks the same gain
+                const float gainDb = static_cast<float>(std::lround(step * gainStep * 10.0f)) * 0.1f;
+                auto setReference = band.setReference;
+                auto setLive = band.setLive;
+
+                cases.push_back({ "NeveEQ", "coefficient tables",
+                                  std::string(band.name) + format(" freq %.0f, %+.1f dB", frequency, gainDb), 0.25f, eqBounds, [=]
+                {
+                    auto reference = std::make_shared<Reference::NeveEQ>();
+                    auto live = std::make_shared<NeveEQ>();
+
+                    return Pair {
+                        [=](double sampleRate, int blockSize)
+                        {
+                            reference->prepare(sampleRate, blockSize);
+                            setReference(*reference, frequency, gainDb);
+                            live->prepare(sampleRate, blockSize);
+                            setLive(*live, frequency, gainDb);
+                        },
+                        [reference](juce::AudioBuffer<float>& buffer) { reference->process(buffer); },
+                        [live](juce::AudioBuffer<float>& buffer) { live->process(buffer); }
+                    };
+                } });
+            }
+        }
+    }
+
+    // All four bands at once, as in the benchmark
+    for (float gainDb : { -12.0f, -6.0f, 6.0f, 12.0f })
+    {
+        cases.push_back({ "NeveEQ", "coefficient tables", format("all bands %+.0f dB", gainDb), 0.25f, eqBounds, [=]
+        {
+            return makePair<Reference::NeveEQ, NeveEQ>([=](auto& e)
+            {
+                e.setHFFreq(NeveEQ::HF_12K);  e.setHFGain(gainDb);
+                e.setHMFreq(NeveEQ::HM_3K2);  e.setHMGain(-gainDb);
+                e.setLMFreq(NeveEQ::LM_360);  e.setLMGain(gainDb);
+                e.setLFFreq(NeveEQ::LF_60);   e.setLFGain(-gainDb);
+            }, [](NeveEQ&) {});
+        } });
+    }
+
+    // === TRANSFORMER ===
+    // Analytic evaluates the reference curve; linear and cubic read the
+    // shaper table. No oversampling and no ADAA: the reference has neither.
+    struct Quality
+    {
+        const char* path;
+        Transformer::Quality quality;
+        Bounds bounds;
+    };
+
+    const Quality qualities[] =
+    {
+        { "shaper analytic", Transformer::QUALITY_ANALYTIC, { 1.0e-5, -100.0, 0.01 } },
+        { "shaper table, linear", Transformer::QUALITY_LINEAR, { 2.0e-3, -60.0, 0.5 } },
+        { "shaper table, cubic", Transformer::QUALITY_CUBIC, { 2.0e-4, -75.0, 0.1 } },
+    };
+
+    for (const auto& q : qualities)
+    {
+        for (int drive = 0; drive <= 100; drive += exhaustive ? 1 : 10)
+        {
+            const auto quality = q.quality;
+
+            cases.push_back({ "Transformer", q.path, format("drive %.0f", drive), 0.7f, q.bounds, [=]
+            {
+                return makePair<Reference::Transformer, Transformer>(
+                    [=](auto& t) { t.setDrive(static_cast<float>(drive)); },
+                    [=](Transformer& t)
+                    {
+                        t.setQuality(quality);
+                        t.setOversampling(0, Oversampler::MODE_IIR);
+                        t.setAntiAliasing(ADAATanh::ORDER_NONE);
+                    });
+            } });
+        }
+    }
+
+    // Tables against the analytic curve for distortion. The low-frequency
+    // term takes up to 30% off the shaper input at full drive, so 1.5 x
+    // tableRange in keeps it spanning the whole table (past it, both sides
+    // evaluate the curve).
+    const float tableInput = 1.5f * Transformer::Shaper::tableRange;
+
+    const Quality tableQualities[] =
+    {
+        { "table vs analytic, linear", Transformer::QUALITY_LINEAR, { 3.0e-4, -85.0, 0.01, 0.0, 0.02 } },
+        { "table vs analytic, cubic", Transformer::QUALITY_CUBIC, { 3.0e-5, -105.0, 0.01, 0.0, 0.01 } },
+    };
+
+    for (const auto& q : tableQualities)
+    {
+        for (int drive = 0; drive <= 100; drive += exhaustive ? 1 : 10)
+        {
+            const auto quality = q.quality;
+
+            cases.push_back({ "Transformer", q.path, format("drive %.0f", drive), tableInput, q.bounds, [=]
+            {
+                return makePair<Transformer, Transformer>(
+                    [=](Transformer& t)
+                    {
+                        t.setDrive(static_cast<float>(drive));
+                        t.setQuality(Transformer::QUALITY_ANALYTIC);
+                        t.setOversampling(0, Oversampler::MODE_IIR);
+                        t.setAntiAliasing(ADAATanh::ORDER_NONE);
+                    },
+                    [=](Transformer& t) { t.setQuality(quality); });
+            } });
+        }
+    }
+
+    // ADAA against the analytic curve it anti-aliases. A 100 Hz tone puts
+    // every harmonic in the band ADAA leaves alone, so THD must match; a
+    // 5 kHz tone folds its upper harmonics, which ADAA must push down.
+    const Bounds adaaBounds { 0.0, 0.0, 0.0, 0.0, 0.05, 0.0, -15.0 };
+
+    for (int drive = 10; drive <= 100; drive += exhaustive ? 1 : 10)
+    {
+        cases.push_back({ "Transformer", "ADAA vs analytic, 1st order", format("drive %.0f", drive), 0.7f, adaaBounds, [=]
+        {
+            return makePair<Transformer, Transformer>(
+                [=](Transformer& t)
+                {
+                    t.setDrive(static_cast<float>(drive));
+                    t.setQuality(Transformer::QUALITY_ANALYTIC);
+                    t.setOversampling(0, Oversampler::MODE_IIR);
+                    t.setAntiAliasing(ADAATanh::ORDER_NONE);
+                },
+                [](Transformer& t) { t.setAntiAliasing(ADAATanh::ORDER_1); });
+        }, 0.0, 100.0 });
+    }
+
+    // === COMPRESSOR ===
+    // Threshold -20 dB against peaks near -3 dBFS: several dB of reduction.
+    // The reference curve steps down at the top of its knee (by 0.75 x knee
+    // x (1 - 1/ratio), up to 3.75 dB); where the envelope crosses that edge
+    // the log2-domain computer can switch a sample earlier or later. Those
+    // samples are masked and bounded as a fraction of the run, so the other
+    // bounds hold everywhere else.
+    const Bounds sampleRateBounds { 1.0e-4, -90.0, 0.01, 0.0, 0.0, 1.0e-4 };
+    const Bounds controlRateBounds { 2.0e-2, -50.0, 0.15, 0.0, 0.0, 1.0e-4 };
+    const char* const ratioNames[] = { "1.5:1", "2:1", "3:1", "4:1", "6:1" };
+    const double ratioValues[] = { 1.5, 2.0, 3.0, 4.0, 6.0 };
+    const char* const attackNames[] = { "fast", "med", "slow" };
+    const char* const releaseNames[] = { "fast", "med", "slow", "auto" };
+
+    for (int controlRate = 0; controlRate <= 1; ++controlRate)
+    {
+        for (int ratio = 0; ratio < 5; ++ratio)
+        for (int attack = 0; attack < 3; ++attack)
+        for (int release = 0; release < 4; ++release)
+        for (int link = 0; link <= 1; ++link)
+        for (int scHPF = 0; scHPF <= 1; ++scHPF)
+        {
+            const std::string setting = std::string(ratioNames[ratio]) + ", attack " + attackNames[attack]
+                                      + ", release " + releaseNames[release] + (link ? ", linked" : ", unlinked")
+                                      + (scHPF ? ", SC HPF" : "");
+
+            cases.push_back({ "NeveCompressor", controlRate ? "gain computer, control rate" : "gain computer, per sample",
+                              setting, 0.7f, controlRate ? controlRateBounds : sampleRateBounds, [=]
+            {
+                return makePair<Reference::NeveCompressor, NeveCompressor>([=](auto& c)
+                {
+                    c.setBypass(false);
+                    c.setThreshold(-20.0f);
+                    c.setRatio(ratio);
+                    c.setAttack(attack);
+                    c.setRelease(release);
+                    c.setMakeup(6.0f);
+                    c.setSidechainHPF(scHPF != 0);
+                    c.setStereoLink(link != 0);
+                }, [=](NeveCompressor& c) { c.setControlRate(controlRate != 0); });
+            }, 0.75 * 6.0 * (1.0 - 1.0 / ratioValues[ratio]) });
+        }
+    }
+
+    // Control rate against the live per-sample computer: the interval choice
+    // and the per-interval step check promise at most 0.1 dB of gain difference
+    const Bounds controlRateGainBounds { 2.0e-2, -40.0, 0.5, 0.1 };
+
+    for (int ratio = 0; ratio < 5; ++ratio)
+    for (int attack = 0; attack < 3; ++attack)
+    for (int release = 0; release < 4; ++release)
+    for (int link = 0; link <= 1; ++link)
+    {
+        const std::string setting = std::string(ratioNames[ratio]) + ", attack " + attackNames[attack]
+                                  + ", release " + releaseNames[release] + (link ? ", linked" : ", unlinked");
+
+        cases.push_back({ "NeveCompressor", "control rate vs per sample", setting, 0.7f, controlRateGainBounds, [=]
+        {
+            return makePair<NeveCompressor, NeveCompressor>([=](NeveCompressor& c)
+            {
+                c.setBypass(false);
+                c.setThreshold(-20.0f);
+                c.setRatio(ratio);
+                c.setAttack(attack);
+                c.setRelease(release);
+                c.setMakeup(6.0f);
+                c.setSidechainHPF(true);
+                c.setStereoLink(link != 0);
+            }, [](NeveCompressor& c) { c.setControlRate(true); });
+        } });
+    }
+
+    // === LIMITER ===
+    // Classic (no lookahead, no oversampling), hot input
+    const Bounds limiterBounds { 1.0e-4, -80.0, 0.05 };
+
+    for (int threshold = -20; threshold <= 0; threshold += exhaustive ? 1 : 2)
+    {
+        cases.push_back({ "NeveLimiter", "classic", format("threshold %.0f dB", threshold), 2.0f, limiterBounds, [=]
+        {
+            return makePair<Reference::NeveLimiter, NeveLimiter>([=](auto& l)
+            {
+                l.setBypass(false);
+                l.setThreshold(static_cast<float>(threshold));
+            }, [](NeveLimiter& l)
+            {
+                l.setLookahead(false);
+                l.setOversampling(0, Oversampler::MODE_IIR);
+            });
+        } });
+    }
+
+    return cases;
+}
+
+// === SIGNALS ===
+
+struct Signal
+{
+    const char* name;
+    juce::AudioBuffer<float> audio;
+};
+
+static std::vector<Signal> makeSignals(double sampleRate, float gain)
+{
+    const int length = static_cast<int>(sampleRate);      // One second each
+    const double twoPi = juce::MathConstants<double>::twoPi;
+    std::vector<Signal> signals;
+
+    // Logarithmic sweep 20 Hz - 20 kHz, right channel 6 dB down
+    {
+        juce::AudioBuffer<float> audio(2, length);
+        const double f0 = 20.0, f1 = std::min(20000.0, 0.45 * sampleRate);
+        const double k = std::log(f1 / f0);
+        const double duration = static_cast<double>(length) / sampleRate;
+
+        for (int i = 0; i < length; ++i)
+        {
+            const double t = static_cast<double>(i) / sampleRate;
+            const double phase = twoPi * f0 * duration / k * (std::exp(t / duration * k) - 1.0);
+            const float value = gain * static_cast<float>(std::sin(phase));
+            audio.getWritePointer(0)[i] = value;
+            audio.getWritePointer(1)[i] = 0.5f * value;
+        }
+
+        signals.push_back({ "sweep", std::move(audio) });
+    }
+
+    // Uniform white noise, independent channels
+    {
+        juce::AudioBuffer<float> audio(2, length);
+        juce::Random random(1234);
+
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < length; ++i)
+                audio.getWritePointer(ch)[i] = gain * (2.0f * random.nextFloat() - 1.0f);
+
+        signals.push_back({ "noise", std::move(audio) });
+    }
+
+    // Transients every 100 ms on a -60 dB floor: an impulse, a 5 ms 1 kHz
+    // burst, then a 30 ms DC step, in turn; the right channel lags 1 ms
+    {
+        juce::AudioBuffer<float> audio(2, length);
+        juce::Random random(99);
+        const int period = static_cast<int>(0.1 * sampleRate);
+        const int lag = static_cast<int>(0.001 * sampleRate);
+
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            auto* data = audio.getWritePointer(ch);
+            for (int i = 0; i < length; ++i)
+                data[i] = gain * 0.001f * (2.0f * random.nextFloat() - 1.0f);
+
+            for (int start = period / 2, event = 0; start < length; start += period, ++event)
+            {
+                const int at = start + ch * lag;
+                if (event % 3 == 0)
+                {
+                    if (at < length)
+                        data[at] += gain;
+                }
+                else if (event % 3 == 1)
+                {
+                    const int burst = static_cast<int>(0.005 * sampleRate);
+                    for (int i = 0; i < burst && at + i < length; ++i)
+                        data[at + i] += gain * static_cast<float>(std::sin(twoPi * 1000.0 * i / sampleRate));
+                }
+                else
+                {
+                    const int step = static_cast<int>(0.03 * sampleRate);
+                    for (int i = 0; i < step && at + i < length; ++i)
+                        data[at + i] += 0.8f * gain;
+                }
+            }
+        }
+
+        signals.push_back({ "transients", std::move(audio) });
+    }
+
+    return signals;
+}
+
+// === METRICS ===
+
+// Welch power spectrum: Hann-windowed 4096-point frames, half overlap, both channels
+static std::vector<double> powerSpectrum(const juce::AudioBuffer<float>& audio)
+{
+    constexpr int order = 12;
+    constexpr int size = 1 << order;
+    juce::dsp::FFT fft(order);
+    std::vector<float> frame(2 * size);
+    std::vector<double> power(size / 2 + 1, 0.0);
+
+    for (int ch = 0; ch < audio.getNumChannels(); ++ch)
+    {
+        const float* data = audio.getReadPointer(ch);
+
+        for (int start = 0; start + size <= audio.getNumSamples(); start += size / 2)
+        {
+            std::fill(frame.begin(), frame.end(), 0.0f);
+            for (int i = 0; i < size; ++i)
+                frame[static_cast<size_t>(i)] = data[start + i]
+                    * static_cast<float>(0.5 - 0.5 * std::cos(juce::MathConstants<double>::twoPi * i / size));
+
+            fft.performFrequencyOnlyForwardTransform(frame.data(), true);
+
+            for (size_t bin = 0; bin < power.size(); ++bin)
+                power[bin] += static_cast<double>(frame[bin]) * frame[bin];
+        }
+    }
+
+    return power;
+}
+
+// Knee-edge flips are within this of the step (control rate adds up to 0.1 dB)
+static constexpr double kneeFlipToleranceDb = 0.15;
+
+static Metrics compare(const juce::AudioBuffer<float>& reference, juce::AudioBuffer<float> live, double kneeStepDb)
+{
+    Metrics m;
+    double errorEnergy = 0.0, referenceEnergy = 0.0;
+    int flips = 0;
+
+    for (int ch = 0; ch < reference.getNumChannels(); ++ch)
+    {
+        const float* r = reference.getReadPointer(ch);
+        float* l = live.getWritePointer(ch);
+
+        for (int i = 0; i < reference.getNumSamples(); ++i)
+        {
+            // A flip takes the reference value, here and in the spectrum below
+            if (kneeStepDb > 0.0 && std::abs(r[i]) > 1.0e-6f
+                && std::abs(std::abs(20.0 * std::log10(std::max(std::abs(static_cast<double>(l[i]) / r[i]), 1.0e-10)))
+                            - kneeStepDb) < kneeFlipToleranceDb)
+            {
+                l[i] = r[i];
+                ++flips;
+            }
+
+            const double error = static_cast<double>(l[i]) - r[i];
+            m.maxAbsError = std::max(m.maxAbsError, std::abs(error));
+
+            // Both sides scale the same input sample, so the output ratio is the gain ratio
+            if (std::abs(r[i]) > 1.0e-6f)
+                m.gainDeviationDb = std::max(m.gainDeviationDb,
+                    std::abs(20.0 * std::log10(std::max(std::abs(static_cast<double>(l[i]) / r[i]), 1.0e-10))));
+            errorEnergy += error * error;
+            referenceEnergy += static_cast<double>(r[i]) * r[i];
+        }
+    }
+
+    m.kneeFlips = static_cast<double>(flips) / (reference.getNumChannels() * reference.getNumSamples());
+
+    if (errorEnergy > 0.0)
+        m.nullDepthDb = 10.0 * std::log10(errorEnergy / std::max(referenceEnergy, 1.0e-30));
+
+    const auto referencePower = powerSpectrum(reference);
+    const auto livePower = powerSpectrum(live);
+    const double floor = *std::max_element(referencePower.begin(), referencePower.end()) * 1.0e-6;
+
+    for (size_t bin = 0; bin < referencePower.size(); ++bin)
+        if (referencePower[bin] > floor && referencePower[bin] > 0.0)
+            m.spectralDeviationDb = std::max(m.spectralDeviationDb,
+                std::abs(10.0 * std::log10(std::max(livePower[bin], 1.0e-30) / referencePower[bin])));
+
+    return m;
+}
+
+// Power of one frequency component (single DFT bin)
+static double binPower(const float* data, int numSamples, double frequency, double sampleRate)
+{
+    const double w = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+    double re = 0.0, im = 0.0;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        re += data[i] * std::cos(w * i);
+        im -= data[i] * std::sin(w * i);
+    }
+
+    return re * re + im * im;
+}
+
+// Total harmonic distortion (2nd-9th, below Nyquist) of a tone, dB; the
+// frequency must fall on a whole number of cycles of the analysed length
+static double totalHarmonicDistortionDb(const float* data, int numSamples, double frequency, double sampleRate)
+{
+    double harmonics = 0.0;
+
+    for (int harmonic = 2; harmonic <= 9 && harmonic * frequency < 0.5 * sampleRate; ++harmonic)
+        harmonics += binPower(data, numSamples, harmonic * frequency, sampleRate);
+
+    const double fundamental = binPower(data, numSamples, frequency, sampleRate);
+    return 10.0 * std::log10(std::max(harmonics, 1.0e-30) / std::max(fundamental, 1.0e-30));
+}
+
+// Harmonics of a tone (up to the 50th) that fold back below the tone itself,
+// against its fundamental, dB. Those are the inharmonic, least masked
+// aliases; the ones folding just under Nyquist are left to oversampling.
+// Every component must fall on a whole number of cycles of the analysed
+// length; each alias bin is counted once.
+static double aliasLevelDb(const float* data, int numSamples, double frequency, double sampleRate)
+{
+    std::vector<double> aliases;
+
+    for (int harmonic = 2; harmonic <= 50; ++harmonic)
+    {
+        const double f = harmonic * frequency;
+        const double folded = std::abs(f - sampleRate * std::round(f / sampleRate));
+
+        if (f >= 0.5 * sampleRate && folded < frequency && std::find(aliases.begin(), aliases.end(), folded) == aliases.end())
+            aliases.push_back(folded);
+    }
+
+    double power = 0.0;
+    for (double f : aliases)
+        power += binPower(data, numSamples, f, sampleRate);
+
+    const double fundamental = binPower(data, numSamples, frequency, sampleRate);
+    return 10.0 * std::log10(std::max(power, 1.0e-30) / std::max(fundamental, 1.0e-30));
+}
+
+// Processes the signal through one side of the pair in blocks of irregular length
+static juce::AudioBuffer<float> render(const std::function<void(juce::AudioBuffer<float>&)>& process,
+                                       const juce::AudioBuffer<float>& signal, int maxBlockSize)
+{
+    static const int lengths[] = { 512, 1, 37, 256, 300, 64, 511, 3 };
+    juce::AudioBuffer<float> output(signal.getNumChannels(), signal.getNumSamples());
+
+    for (int ch = 0; ch < signal.getNumChannels(); ++ch)
+        output.copyFrom(ch, 0, signal, ch, 0, signal.getNumSamples());
+
+    float* channels[2] = { output.getWritePointer(0), output.getWritePointer(1) };
+
+    for (int position = 0, next = 0; position < output.getNumSamples(); next = (next + 1) % 8)
+    {
+        const int numSamples = std::min({ lengths[next], maxBlockSize, output.getNumSamples() - position });
+        float* block[2] = { channels[0] + position, channels[1] + position };
+        juce::AudioBuffer<float> view(block, 2, numSamples);
+
+        process(view);
+        position += numSamples;
+    }
+
+    return output;
+}
+
+static Metrics runCase(const Case& c, double sampleRate, std::vector<Signal>& signals)
+{
+    juce::ScopedNoDenormals noDenormals;
+    constexpr int maxBlockSize = 512;
+    const bool tonesOnly = c.bounds.aliasChangeDb < 0.0;
+    Metrics worst;
+
+    for (const auto& signal : signals)
+    {
+        if (tonesOnly)
+            break;
+
+        // A fresh pair per signal, so one signal's tail does not feed the next
+        Pair pair = c.create();
+        pair.prepare(sampleRate, maxBlockSize);
+
+        const auto reference = render(pair.processReference, signal.audio, maxBlockSize);
+        const auto live = render(pair.processLive, signal.audio, maxBlockSize);
+        worst.takeWorst(compare(reference, live, c.kneeStepDb));
+    }
+
+    // Tones at four octaves below the input gain up to it, one second each,
+    // analysed over the second half, after the DC blocker has settled (whole
+    // cycles of every component at both sample rates)
+    const int length = static_cast<int>(sampleRate);
+    const int settled = length / 2;
+
+    auto renderTone = [&](double frequency, float level)
+    {
+        juce::AudioBuffer<float> tone(2, length);
+        for (int i = 0; i < length; ++i)
+        {
+            const float value = level * static_cast<float>(std::sin(juce::MathConstants<double>::twoPi * frequency * i / sampleRate));
+            tone.getWritePointer(0)[i] = value;
+            tone.getWritePointer(1)[i] = value;
+        }
+
+        Pair pair = c.create();
+        pair.prepare(sampleRate, maxBlockSize);
+
+        return std::make_pair(render(pair.processReference, tone, maxBlockSize),
+                              render(pair.processLive, tone, maxBlockSize));
+    };
+
+    for (float level = c.inputGain / 16.0f; level <= c.inputGain; level *= 2.0f)
+    {
+        if (c.bounds.thdDeviationDb > 0.0)
+        {
+            const auto [reference, live] = renderTone(c.toneHz, level);
+            const double deviation = std::abs(
+                totalHarmonicDistortionDb(live.getReadPointer(0) + settled, length - settled, c.toneHz, sampleRate)
+                - totalHarmonicDistortionDb(reference.getReadPointer(0) + settled, length - settled, c.toneHz, sampleRate));
+
+            worst.thdDeviationDb = std::max(worst.thdDeviationDb, deviation);
+        }
+
+        if (tonesOnly)
+        {
+            constexpr double aliasToneHz = 5000.0;
+            const auto [reference, live] = renderTone(aliasToneHz, level);
+            const double referenceAliases = aliasLevelDb(reference.getReadPointer(0) + settled, length - settled, aliasToneHz, sampleRate);
+            const double liveAliases = aliasLevelDb(live.getReadPointer(0) + settled, length - settled, aliasToneHz, sampleRate);
+
+            worst.aliasChangeDb = std::max(worst.aliasChangeDb, liveAliases - referenceAliases);
+        }
+    }
+
+    return worst;
+}
+
+struct PathSummary
+{
+    std::string module, path;
+    Bounds bounds;
+    Metrics worst;
+    int cases = 0;
+    int failures = 0;
+};
+
+int main(int argc, char* argv[])
+{
+    const juce::ArgumentList arguments(argc, argv);
+    const bool exhaustive = arguments.containsOption("--exhaustive");
+    const bool verbose = arguments.containsOption("--verbose");
+    const juce::String moduleFilter = arguments.getValueForOption("--module");
+    const juce::String outputPath = arguments.getValueForOption("--output");
+
+    const double sampleRates[] = { 44100.0, 96000.0 };
+    std::vector<PathSummary> summaries;
+
+    for (const auto& c : makeCases(exhaustive))
+    {
+        if (moduleFilter.isNotEmpty() && moduleFilter != c.module)
+            continue;
+
+        auto summary = std::find_if(summaries.begin(), summaries.end(),
+            [&c](const PathSummary& s) { return s.module == c.module && s.path == c.path; });
+
+        if (summary == summaries.end())
+        {
+            summaries.push_back({ c.module, c.path, c.bounds, {}, 0, 0 });
+            summary = summaries.end() - 1;
+        }
+
+        for (double sampleRate : sampleRates)
+        {
+            auto signals = makeSignals(sampleRate, c.inputGain);
+            const Metrics m = runCase(c, sampleRate, signals);
+            const bool pass = m.within(c.bounds);
+
+            summary->worst.takeWorst(m);
+            ++summary->cases;
+            summary->failures += pass ? 0 : 1;
+
+            if (verbose || ! pass)
+                std::fprintf(stderr, "%s %-15s %-28s %-44s %6.0f Hz  max %.2e  null %7.1f dB  spectrum %6.3f dB  gain %6.3f dB  THD %6.3f dB  flips %.2e  aliases %6.1f dB\n",
+                             pass ? "  ok" : "FAIL", c.module, c.path, c.setting.c_str(), sampleRate,
+                             m.maxAbsError, m.nullDepthDb, m.spectralDeviationDb, m.gainDeviationDb, m.thdDeviationDb, m.kneeFlips,
+                             m.aliasChangeDb);
+        }
+    }
+
+    int failures = 0;
+    std::printf("%-15s %-28s %6s  %-22s %-22s %s\n", "module", "path", "cases",
+                "max abs error (bound)", "null dB (bound)", "spectrum dB (bound)");
+
+    for (const auto& s : summaries)
+    {
+        if (s.bounds.aliasChangeDb < 0.0)
+            std::printf("%-15s %-28s %6d  tones only%s\n", s.module.c_str(), s.path.c_str(), s.cases,
+                        s.failures > 0 ? "  FAIL" : "");
+        else
+            std::printf("%-15s %-28s %6d  %.2e (%.0e)     %7.1f (%6.1f)       %6.3f (%.2f)%s\n",
+                        s.module.c_str(), s.path.c_str(), s.cases,
+                        s.worst.maxAbsError, s.bounds.maxAbsError, s.worst.nullDepthDb, s.bounds.nullDepthDb,
+                        s.worst.spectralDeviationDb, s.bounds.spectralDeviationDb,
+                        s.failures > 0 ? "  FAIL" : "");
+
+        if (s.bounds.gainDeviationDb > 0.0)
+            std::printf("%-15s %-28s %6s  gain deviation %.3f dB (%.2f)\n", "", "", "",
+                        s.worst.gainDeviationDb, s.bounds.gainDeviationDb);
+        if (s.bounds.thdDeviationDb > 0.0)
+            std::printf("%-15s %-28s %6s  THD deviation %.3f dB (%.2f)\n", "", "", "",
+                        s.worst.thdDeviationDb, s.bounds.thdDeviationDb);
+        if (s.bounds.kneeFlips > 0.0)
+            std::printf("%-15s %-28s %6s  knee-edge flips %.2e of samples (%.0e)\n", "", "", "",
+                        s.worst.kneeFlips, s.bounds.kneeFlips);
+        if (s.bounds.aliasChangeDb < 0.0)
+            std::printf("%-15s %-28s %6s  alias change %.1f dB (%.1f)\n", "", "", "",
+                        s.worst.aliasChangeDb, s.bounds.aliasChangeDb);
+        failures += s.failures;
+    }
+
+    if (outputPath.isNotEmpty())
+    {
+        std::FILE* out = std::fopen(outputPath.toRawUTF8(), "w");
+        if (out == nullptr)
+        {
+            std::fprintf(stderr, "cannot write %s\n", outputPath.toRawUTF8());
+            return 1;
+        }
+
+        std::fprintf(out, "{\n  \"harness\": \"NeveStripEquivalence\",\n  \"exhaustive\": %s,\n  \"paths\": [",
+                     exhaustive ? "true" : "false");
+
+        for (size_t i = 0; i < summaries.size(); ++i)
+        {
+            const auto& s = summaries[i];
+            std::fprintf(out, "%s\n    { \"module\": \"%s\", \"path\": \"%s\", \"cases\": %d, \"failures\": %d, "
+                              "\"maxAbsError\": %.3e, \"nullDepthDb\": %.2f, \"spectralDeviationDb\": %.4f, \"gainDeviationDb\": %.4f, "
+                              "\"thdDeviationDb\": %.4f, \"kneeFlips\": %.3e, \"aliasChangeDb\": %.2f, "
+                              "\"bounds\": { \"maxAbsError\": %.3e, \"nullDepthDb\": %.2f, \"spectralDeviationDb\": %.4f, "
+                              "\"gainDeviationDb\": %.4f, \"thdDeviationDb\": %.4f, \"kneeFlips\": %.3e, \"aliasChangeDb\": %.2f } }",
+                         i > 0 ? "," : "", s.module.c_str(), s.path.c_str(), s.cases, s.failures,
+                         s.worst.maxAbsError, s.worst.nullDepthDb, s.worst.spectralDeviationDb, s.worst.gainDeviationDb,
+                         s.worst.thdDeviationDb, s.worst.kneeFlips, s.worst.aliasChangeDb,
+                         s.bounds.maxAbsError, s.bounds.nullDepthDb, s.bounds.spectralDeviationDb, s.bounds.gainDeviationDb,
+                         s.bounds.thdDeviationDb, s.bounds.kneeFlips, s.bounds.aliasChangeDb);
+        }
+
+        std::fprintf(out, "\n  ]\n}\n");
+        std::fclose(out);
+    }
+
+    std::printf("%d case runs out of bounds\n", failures);
+    return failures == 0 ? 0 : 1;
+}
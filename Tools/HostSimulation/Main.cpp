@@ -0,0 +1,314 @@
+/*
+ * NeveStripHostSimulation - end-to-end stress benchmark of the processor
+ *
+ * Drives NeveStripAudioProcessor the way a host does: a dedicated audio
+ * thread calls processBlock back to back, while the main thread runs the
+ * JUCE message loop (so parameter listeners, the parameter service and the
+ * analysis timer all run concurrently, as in a real session).
+ *
+ * Scenarios:
+ * - steady: fixed blocks of the prepared size
+ * - jittered: uniformly random lengths up to the prepared size
+ * - small and odd: 1- to 127-sample blocks, mostly odd lengths
+ * - each of the above with automation bursts: every 50 ms, 20 ms of
+ *   blocks that each move several random parameters through the APVTS
+ *   from the audio thread (as plugin wrappers deliver host automation)
+ *
+ * Every callback of every instance is timed. Per scenario the report
+ * gives the distribution (p50/p90/p99/p99.9/max) of callback load (time
+ * over the block's duration) and of ns per sample, across all instances.
+ *
+ * Usage: NeveStripHostSimulation [--rate=48000] [--block=512] [--instances=1]
+ *                                [--seconds=10] [--output=file.json]
+ */
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+struct Settings
+{
+    double sampleRate = 48000.0;
+    int blockSize = 512;
+    int instances = 1;
+    double seconds = 10.0;
+};
+
+enum BlockPattern { PATTERN_STEADY = 0, PATTERN_JITTERED, PATTERN_SMALL_ODD };
+
+struct Scenario
+{
+    const char* name;
+    BlockPattern pattern;
+    bool automation;
+};
+
+static const Scenario scenarios[] =
+{
+    { "steady",                             PATTERN_STEADY,    false },
+    { "jittered",                           PATTERN_JITTERED,  false },
+    { "small and odd",                      PATTERN_SMALL_ODD, false },
+    { "steady + automation bursts",         PATTERN_STEADY,    true },
+    { "jittered + automation bursts",       PATTERN_JITTERED,  true },
+    { "small and odd + automation bursts",  PATTERN_SMALL_ODD, true },
+};
+
+// Engine switches change latency or rebuild tables; hosts rarely automate them
+static const char* const notAutomated[] =
+{
+    "masterBypass", "osFactor", "osMode", "transformerAA", "transformerQuality", "limMode"
+};
+
+struct Distribution
+{
+    double p50 = 0.0, p90 = 0.0, p99 = 0.0, p999 = 0.0, max = 0.0;
+
+    static Distribution of(std::vector<double>& values)
+    {
+        Distribution d;
+        if (values.empty())
+            return d;
+
+        std::sort(values.begin(), values.end());
+        auto at = [&values](double q) { return values[static_cast<size_t>(q * static_cast<double>(values.size() - 1))]; };
+
+        d.p50 = at(0.5);
+        d.p90 = at(0.9);
+        d.p99 = at(0.99);
+        d.p999 = at(0.999);
+        d.max = values.back();
+        return d;
+    }
+};
+
+struct ScenarioResult
+{
+    const Scenario* scenario = nullptr;
+    size_t callbacks = 0;
+    double meanBlockSize = 0.0;
+    Distribution load;
+    Distribution nsPerSample;
+    size_t overruns = 0;
+};
+
+class HostSimulation
+{
+public:
+    explicit HostSimulation(const Settings& s) : settings(s)
+    {
+        for (int i = 0; i < settings.instances; ++i)
+        {
+            Instance instance;
+            instance.processor = std::make_unique<NeveStripAudioProcessor>();
+            instance.processor->setPlayConfigDetails(2, 2, settings.sampleRate, settings.blockSize);
+
+            for (auto* p : instance.processor->getParameters())
+            {
+                auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(p);
+                if (ranged != nullptr && std::find_if(std::begin(notAutomated), std::end(notAutomated),
+                        [ranged](const char* id) { return ranged->getParameterID() == id; }) == std::end(notAutomated))
+                    instance.automatable.push_back(ranged);
+            }
+
+            instances.push_back(std::move(instance));
+        }
+
+        buffer.setSize(2, settings.blockSize);
+    }
+
+    // Audio thread
+    ScenarioResult run(const Scenario& scenario)
+    {
+        for (auto& instance : instances)
+        {
+            instance.processor->releaseResources();
+            instance.processor->prepareToPlay(settings.sampleRate, settings.blockSize);
+        }
+
+        std::vector<double> loads, nsPerSample;
+        const size_t expectedCallbacks = static_cast<size_t>(settings.seconds * settings.sampleRate) * instances.size();
+        loads.reserve(expectedCallbacks);
+        nsPerSample.reserve(expectedCallbacks);
+
+        const int64_t totalSamples = static_cast<int64_t>(settings.seconds * settings.sampleRate);
+        const int burstPeriod = static_cast<int>(0.05 * settings.sampleRate);
+        const int burstLength = static_cast<int>(0.02 * settings.sampleRate);
+
+        ScenarioResult result;
+        result.scenario = &scenario;
+        int64_t position = 0;
+        size_t blocks = 0;
+
+        while (position < totalSamples)
+        {
+            const int numSamples = nextBlockSize(scenario.pattern);
+            const bool inBurst = scenario.automation && (position % burstPeriod) < burstLength;
+            const double deadlineNs = 1.0e9 * numSamples / settings.sampleRate;
+
+            for (auto& instance : instances)
+            {
+                fillInput(numSamples, position);
+                juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), 2, numSamples);
+
+                // Host automation lands just before the callback that uses it
+                if (inBurst)
+                    automate(instance);
+
+                const auto start = std::chrono::steady_clock::now();
+                instance.processor->processBlock(block, midi);
+                const double elapsedNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+                loads.push_back(elapsedNs / deadlineNs);
+                nsPerSample.push_back(elapsedNs / numSamples);
+                result.overruns += elapsedNs > deadlineNs ? 1 : 0;
+            }
+
+            position += numSamples;
+            ++blocks;
+        }
+
+        result.callbacks = loads.size();
+        result.meanBlockSize = static_cast<double>(totalSamples) / static_cast<double>(juce::jmax<size_t>(1, blocks));
+        result.load = Distribution::of(loads);
+        result.nsPerSample = Distribution::of(nsPerSample);
+        return result;
+    }
+
+private:
+    // A processor and the parameters of its own that automation may move
+    struct Instance
+    {
+        std::unique_ptr<NeveStripAudioProcessor> processor;
+        std::vector<juce::RangedAudioParameter*> automatable;
+    };
+
+    int nextBlockSize(BlockPattern pattern)
+    {
+        static const int smallOdd[] = { 1, 2, 3, 5, 7, 13, 16, 31, 33, 47, 64, 99, 127 };
+
+        switch (pattern)
+        {
+            case PATTERN_JITTERED:  return 1 + random.nextInt(settings.blockSize);
+            case PATTERN_SMALL_ODD: return juce::jmin(settings.blockSize, smallOdd[random.nextInt(juce::numElementsInArray(smallOdd))]);
+            case PATTERN_STEADY:
+            default:                return settings.blockSize;
+        }
+    }
+
+    void automate(Instance& instance)
+    {
+        const auto& parameters = instance.automatable;
+        const int changes = 2 + random.nextInt(7);
+        for (int i = 0; i < changes; ++i)
+            parameters[static_cast<size_t>(random.nextInt(static_cast<int>(parameters.size())))]
+                ->setValueNotifyingHost(random.nextFloat());
+    }
+
+    // A tone over noise at a level that keeps the dynamics working
+    void fillInput(int numSamples, int64_t position)
+    {
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            auto* data = buffer.getWritePointer(ch);
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const double t = static_cast<double>(position + i) / settings.sampleRate;
+                data[i] = 0.7f * static_cast<float>(std::sin(juce::MathConstants<double>::twoPi * 220.0 * t))
+                        + 0.05f * (random.nextFloat() - 0.5f);
+            }
+        }
+    }
+
+    const Settings settings;
+    std::vector<Instance> instances;
+    juce::AudioBuffer<float> buffer;
+    juce::MidiBuffer midi;
+    juce::Random random { 7 };
+};
+
+static void printDistribution(std::FILE* out, const char* name, const Distribution& d, bool last)
+{
+    std::fprintf(out, "      \"%s\": { \"p50\": %.4f, \"p90\": %.4f, \"p99\": %.4f, \"p999\": %.4f, \"max\": %.4f }%s\n",
+                 name, d.p50, d.p90, d.p99, d.p999, d.max, last ? "" : ",");
+}
+
+static void writeReport(std::FILE* out, const Settings& settings, const std::vector<ScenarioResult>& results)
+{
+    std::fprintf(out, "{\n  \"benchmark\": \"NeveStripHostSimulation\",\n  \"sampleRate\": %.0f,\n"
+                      "  \"blockSize\": %d,\n  \"instances\": %d,\n  \"seconds\": %.1f,\n  \"scenarios\": [\n",
+                 settings.sampleRate, settings.blockSize, settings.instances, settings.seconds);
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const auto& r = results[i];
+        std::fprintf(out, "    {\n      \"name\": \"%s\",\n      \"callbacks\": %zu,\n      \"meanBlockSize\": %.1f,\n"
+                          "      \"overruns\": %zu,\n",
+                     r.scenario->name, r.callbacks, r.meanBlockSize, r.overruns);
+        printDistribution(out, "load", r.load, false);
+        printDistribution(out, "nsPerSample", r.nsPerSample, true);
+        std::fprintf(out, "    }%s\n", i + 1 < results.size() ? "," : "");
+    }
+
+    std::fprintf(out, "  ]\n}\n");
+}
+
+int main(int argc, char* argv[])
+{
+    const juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    const juce::ArgumentList arguments(argc, argv);
+
+    Settings settings;
+    auto option = [&arguments](const char* name, double fallback)
+    {
+        const auto value = arguments.getValueForOption(name);
+        return value.isNotEmpty() ? value.getDoubleValue() : fallback;
+    };
+
+    settings.sampleRate = option("--rate", settings.sampleRate);
+    settings.blockSize = juce::jmax(1, static_cast<int>(option("--block", settings.blockSize)));
+    settings.instances = juce::jmax(1, static_cast<int>(option("--instances", settings.instances)));
+    settings.seconds = option("--seconds", settings.seconds);
+
+    HostSimulation simulation(settings);
+    std::vector<ScenarioResult> results;
+
+    // The audio thread runs every scenario, then ends the message loop
+    std::thread audioThread([&]
+    {
+        for (const auto& scenario : scenarios)
+        {
+            results.push_back(simulation.run(scenario));
+
+            const auto& r = results.back();
+            std::fprintf(stderr, "%-36s load p50 %6.2f%%  p99 %6.2f%%  p99.9 %6.2f%%  max %7.2f%%  overruns %zu\n",
+                         scenario.name, 100.0 * r.load.p50, 100.0 * r.load.p99, 100.0 * r.load.p999,
+                         100.0 * r.load.max, r.overruns);
+        }
+
+        juce::MessageManager::getInstance()->stopDispatchLoop();
+    });
+
+    juce::MessageManager::getInstance()->runDispatchLoop();
+    audioThread.join();
+
+    const juce::String outputPath = arguments.getValueForOption("--output");
+    std::FILE* out = outputPath.isNotEmpty() ? std::fopen(outputPath.toRawUTF8(), "w") : stdout;
+    if (out == nullptr)
+    {
+        std::fprintf(stderr, "cannot write %s\n", outputPath.toRawUTF8());
+        return 1;
+    }
+
+    writeReport(out, settings, results);
+
+    if (out != stdout)
+        std::fclose(out);
+
+    return 0;
+}
@@ -0,0 +1,256 @@
+/*
+ * NeveStripRealtimeCheck - headless realtime-safety driver
+ *
+ * Runs NeveStripAudioProcessor with no host and no editor under the
+ * allocation and lock traps of RealtimeInterposer. processBlock marks
+ * itself as a realtime scope (NEVESTRIP_RT_SCOPE), so any malloc, free,
+ * new, delete or mutex wait it makes is printed with a stack trace.
+ *
+ * Coverage:
+ * - every combination of the engine switches (oversampling factor and
+ *   filter, anti-aliasing, shaper, limiter mode, control-rate GR, EQ
+ *   routing and the bypasses), each with blocks of irregular size
+ * - every sample rate x maximum block size, stepping each remaining
+ *   parameter through all its choices (continuous ones: min, default, max)
+ * - meter frames and true-peak analysis subscribed throughout
+ * - every parameter change delivered inside a realtime scope, as host
+ *   automation arrives on the audio thread, so the parameter listeners are
+ *   checked along with processBlock
+ *
+ * Usage: NeveStripRealtimeCheck [--quick] [--abort]
+ *   --quick  skip the engine-switch cross product
+ *   --abort  abort at the first violation (for a core dump / debugger)
+ *
+ * Exit status is 1 if anything was trapped.
+ */
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "RealtimeInterposer.h"
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+// Parameters that switch code paths; visited as a full cross product
+static const char* const engineSwitches[] =
+{
+    "osFactor", "osMode", "transformerAA", "transformerQuality", "limMode",
+    "compControlRate", "eqPrePost", "eqBypass", "compBypass", "limBypass", "masterBypass"
+};
+
+static const double sampleRates[] = { 44100.0, 48000.0, 88200.0, 96000.0, 192000.0 };
+static const int maximumBlockSizes[] = { 32, 64, 128, 256, 512, 1024, 2048, 4096 };
+
+// Normalised values to visit: every step of a switch, otherwise the ends and the default
+static std::vector<float> valuesToVisit(const juce::RangedAudioParameter& parameter)
+{
+    const int steps = parameter.getNumSteps();
+
+    if (parameter.isDiscrete() && steps <= 16)
+    {
+        std::vector<float> values;
+        for (int step = 0; step < steps; ++step)
+            values.push_back(static_cast<float>(step) / static_cast<float>(juce::jmax(1, steps - 1)));
+        return values;
+    }
+
+    return { 0.0f, parameter.getDefaultValue(), 1.0f };
+}
+
+class Driver
+{
+public:
+    Driver()
+    {
+        for (auto* p : processor.getParameters())
+            if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(p))
+                parameters.add(ranged);
+
+        processor.subscribeMeterFrames();
+        processor.subscribeTruePeak();
+    }
+
+    ~Driver()
+    {
+        processor.unsubscribeTruePeak();
+        processor.unsubscribeMeterFrames();
+    }
+
+    void prepare(double sampleRate, int maximumBlockSize)
+    {
+        processor.setRateAndBufferSizeDetails(sampleRate, maximumBlockSize);
+        processor.prepareToPlay(sampleRate, maximumBlockSize);
+        buffer.setSize(2, maximumBlockSize);
+        maxBlock = maximumBlockSize;
+        context = juce::String(sampleRate) + " Hz, " + juce::String(maximumBlockSize) + " max";
+    }
+
+    juce::RangedAudioParameter* getParameter(const juce::String& id)
+    {
+        return processor.getAPVTS().getParameter(id);
+    }
+
+    // As a plugin wrapper applies automation: setValue() on the audio
+    // thread, which reaches parameterChanged() through the APVTS. The
+    // wrapper's own host notification is JUCE's and is not checked.
+    void setParameter(juce::RangedAudioParameter& parameter, float value)
+    {
+        const uint64_t before = RealtimeInterposer::getNumViolations();
+
+        {
+            const RealtimeGuard::Scope scope(true);
+            parameter.setValue(value);
+        }
+
+        parameter.sendValueChangedMessageToListeners(value);
+
+        if (RealtimeInterposer::getNumViolations() != before)
+            std::fprintf(stderr, "    ^ %s, automation: %s = %g\n", context.toRawUTF8(),
+                         parameter.getParameterID().toRawUTF8(), static_cast<double>(value));
+    }
+
+    // A few realtime blocks of irregular length after a parameter change
+    void run(const juce::String& what)
+    {
+        applyModuleChanges();
+
+        const int lengths[] = { maxBlock, 1, 7, maxBlock / 3 + 1, maxBlock - 1, maxBlock };
+        const uint64_t before = RealtimeInterposer::getNumViolations();
+
+        for (int length : lengths)
+        {
+            const uint64_t blockBefore = RealtimeInterposer::getNumViolations();
+            processBlock(juce::jmax(1, length));
+
+            if (RealtimeInterposer::getNumViolations() != blockBefore)
+                std::fprintf(stderr, "    ^ %s, %d samples: %s\n", context.toRawUTF8(), length, what.toRawUTF8());
+        }
+
+        ++runs;
+        if (RealtimeInterposer::getNumViolations() != before)
+            ++failedRuns;
+    }
+
+    juce::Array<juce::RangedAudioParameter*> parameters;
+    int runs = 0;
+    int blocks = 0;
+    int failedRuns = 0;
+
+private:
+    // The parameter service applies engine changes asynchronously; an offline
+    // block does it synchronously (so each run sees its settings) and is not
+    // a realtime scope
+    void applyModuleChanges()
+    {
+        processor.setNonRealtime(true);
+        processBlock(juce::jmin(64, maxBlock));
+        processor.setNonRealtime(false);
+    }
+
+    void processBlock(int numSamples)
+    {
+        juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), 2, numSamples);
+
+        // A hot tone over noise, so the dynamics and the clipper all engage
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            auto* data = block.getWritePointer(ch);
+            for (int i = 0; i < numSamples; ++i)
+            {
+                data[i] = 1.5f * std::sin(phase + 0.3f * static_cast<float>(ch)) + 0.1f * (random.nextFloat() - 0.5f);
+                phase += 0.05f;
+            }
+        }
+        phase = std::fmod(phase, juce::MathConstants<float>::twoPi);
+
+        processor.processBlock(block, midi);
+        ++blocks;
+
+        NeveStripAudioProcessor::MeterFrame frame;
+        while (processor.popMeterFrame(frame)) {}
+    }
+
+    NeveStripAudioProcessor processor;
+    juce::AudioBuffer<float> buffer;
+    juce::MidiBuffer midi;
+    juce::Random random { 1 };
+    float phase = 0.0f;
+    int maxBlock = 512;
+    juce::String context;
+};
+
+static void runEngineSwitches(Driver& driver)
+{
+    std::vector<std::vector<float>> values;
+    for (auto* id : engineSwitches)
+        values.push_back(valuesToVisit(*driver.getParameter(id)));
+
+    // Odometer over the cross product
+    std::vector<size_t> index(values.size(), 0);
+
+    for (;;)
+    {
+        juce::String what;
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            driver.setParameter(*driver.getParameter(engineSwitches[i]), values[i][index[i]]);
+            what << engineSwitches[i] << "=" << values[i][index[i]] << " ";
+        }
+
+        driver.run(what);
+
+        size_t digit = 0;
+        while (digit < index.size() && ++index[digit] == values[digit].size())
+            index[digit++] = 0;
+
+        if (digit == index.size())
+            break;
+    }
+}
+
+static void runParameterSweep(Driver& driver)
+{
+    for (auto* parameter : driver.parameters)
+    {
+        for (float value : valuesToVisit(*parameter))
+        {
+            driver.setParameter(*parameter, value);
+            driver.run(parameter->getParameterID() + " = " + parameter->getCurrentValueAsText());
+        }
+
+        driver.setParameter(*parameter, parameter->getDefaultValue());
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    const juce::ArgumentList arguments(argc, argv);
+
+    RealtimeInterposer::setAbortOnViolation(arguments.containsOption("--abort"));
+
+    Driver driver;
+
+    if (! arguments.containsOption("--quick"))
+    {
+        std::printf("engine switches (48 kHz, 512)...\n");
+        driver.prepare(48000.0, 512);
+        runEngineSwitches(driver);
+    }
+
+    for (double sampleRate : sampleRates)
+    {
+        for (int maximumBlockSize : maximumBlockSizes)
+        {
+            std::printf("parameter sweep (%g Hz, %d)...\n", sampleRate, maximumBlockSize);
+            driver.prepare(sampleRate, maximumBlockSize);
+            runParameterSweep(driver);
+        }
+    }
+
+    const auto violations = RealtimeInterposer::getNumViolations();
+    std::printf("%d runs, %d blocks: %llu realtime violations in %d runs\n", driver.runs, driver.blocks,
+                static_cast<unsigned long long>(violations), driver.failedRuns);
+
+    return violations == 0 ? 0 : 1;
+}
@@ -0,0 +1,288 @@
+#include "RealtimeInterposer.h"
+#include "Instrumentation/RealtimeGuard.h"
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if defined(__linux__) || defined(__APPLE__)
+ #include <dlfcn.h>
+ #include <execinfo.h>
+ #include <pthread.h>
+ #include <unistd.h>
+ #define NEVESTRIP_INTERPOSE_C 1
+#else
+ #define NEVESTRIP_INTERPOSE_C 0
+#endif
+
+static std::atomic<uint64_t> violations { 0 };
+static std::atomic<bool> abortOnViolation { false };
+
+uint64_t RealtimeInterposer::getNumViolations() { return violations.load(); }
+void RealtimeInterposer::setAbortOnViolation(bool shouldAbort) { abortOnViolation.store(shouldAbort); }
+
+static void writeError(const char* text)
+{
+   #if NEVESTRIP_INTERPOSE_C
+    // write() rather than stdio: no locks or buffers of its own
+    const ssize_t ignored = ::write(STDERR_FILENO, text, std::strlen(text));
+    (void) ignored;
+   #else
+    std::fputs(text, stderr);
+   #endif
+}
+
+static void report(const char* call)
+{
+    RealtimeGuard::suspended = true;
+    violations.fetch_add(1);
+
+    writeError("\n*** realtime violation: ");
+    writeError(call);
+    writeError(" inside a realtime scope\n");
+
+   #if NEVESTRIP_INTERPOSE_C
+    void* frames[48];
+    const int numFrames = ::backtrace(frames, 48);
+    ::backtrace_symbols_fd(frames + 1, numFrames - 1, STDERR_FILENO);  // Skips report() itself
+   #endif
+
+    if (abortOnViolation.load())
+        std::abort();
+
+    RealtimeGuard::suspended = false;
+}
+
+static inline void check(const char* call)
+{
+    if (RealtimeGuard::isActive())
+        report(call);
+}
+
+//==============================================================================
+// The allocator underneath the traps
+//==============================================================================
+#if defined(__linux__)
+extern "C"
+{
+    // glibc's own entry points: no dlsym() needed, which itself allocates
+    void* __libc_malloc(size_t);
+    void* __libc_calloc(size_t, size_t);
+    void* __libc_realloc(void*, size_t);
+    void* __libc_memalign(size_t, size_t);
+    void __libc_free(void*);
+}
+
+static void* realMalloc(size_t size) { return __libc_malloc(size); }
+static void* realCalloc(size_t count, size_t size) { return __libc_calloc(count, size); }
+static void* realRealloc(void* p, size_t size) { return __libc_realloc(p, size); }
+static void* realMemalign(size_t alignment, size_t size) { return __libc_memalign(alignment, size); }
+static void realFree(void* p) { __libc_free(p); }
+#else
+// Calls from this file are never redirected to its own interposers
+static void* realMalloc(size_t size) { return std::malloc(size); }
+static void* realCalloc(size_t count, size_t size) { return std::calloc(count, size); }
+static void* realRealloc(void* p, size_t size) { return std::realloc(p, size); }
+static void realFree(void* p) { std::free(p); }
+
+static void* realMemalign(size_t alignment, size_t size)
+{
+   #if NEVESTRIP_INTERPOSE_C
+    void* p = nullptr;
+    return ::posix_memalign(&p, alignment, size) == 0 ? p : nullptr;
+   #else
+    return ::_aligned_malloc(size, alignment);
+   #endif
+}
+#endif
+
+//==============================================================================
+// C++ allocation (every platform)
+//==============================================================================
+static void* newOrThrow(size_t size, size_t alignment, const char* call)
+{
+    check(call);
+
+    if (size == 0)
+        size = 1;
+
+    if (void* p = alignment > alignof(std::max_align_t) ? realMemalign(alignment, size) : realMalloc(size))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+static void* newOrNull(size_t size, size_t alignment, const char* call) noexcept
+{
+    try { return newOrThrow(size, alignment, call); }
+    catch (...) { return nullptr; }
+}
+
+static void deleteChecked(void* p, bool aligned, const char* call) noexcept
+{
+    if (p == nullptr)
+        return;
+
+    check(call);
+
+   #if ! NEVESTRIP_INTERPOSE_C
+    if (aligned)
+    {
+        ::_aligned_free(p);
+        return;
+    }
+   #else
+    (void) aligned;
+   #endif
+
+    realFree(p);
+}
+
+static constexpr size_t defaultAlignment = alignof(std::max_align_t);
+
+void* operator new(size_t size) { return newOrThrow(size, defaultAlignment, "operator new"); }
+void* operator new[](size_t size) { return newOrThrow(size, defaultAlignment, "operator new[]"); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return newOrNull(size, defaultAlignment, "operator new"); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return newOrNull(size, defaultAlignment, "operator new[]"); }
+void* operator new(size_t size, std::align_val_t a) { return newOrThrow(size, static_cast<size_t>(a), "operator new"); }
+void* operator new[](size_t size, std::align_val_t a) { return newOrThrow(size, static_cast<size_t>(a), "operator new[]"); }
+void* operator new(size_t size, std::align_val_t a, const std::nothrow_t&) noexcept { return newOrNull(size, static_cast<size_t>(a), "operator new"); }
+void* operator new[](size_t size, std::align_val_t a, const std::nothrow_t&) noexcept { return newOrNull(size, static_cast<size_t>(a), "operator new[]"); }
+
+void operator delete(void* p) noexcept { deleteChecked(p, false, "operator delete"); }
+void operator delete[](void* p) noexcept { deleteChecked(p, false, "operator delete[]"); }
+void operator delete(void* p, size_t) noexcept { deleteChecked(p, false, "operator delete"); }
+void operator delete[](void* p, size_t) noexcept { deleteChecked(p, false, "operator delete[]"); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { deleteChecked(p, false, "operator delete"); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { deleteChecked(p, false, "operator delete[]"); }
+void operator delete(void* p, std::align_val_t) noexcept { deleteChecked(p, true, "operator delete"); }
+void operator delete[](void* p, std::align_val_t) noexcept { deleteChecked(p, true, "operator delete[]"); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { deleteChecked(p, true, "operator delete"); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { deleteChecked(p, true, "operator delete[]"); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { deleteChecked(p, true, "operator delete"); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { deleteChecked(p, true, "operator delete[]"); }
+
+//==============================================================================
+// C allocation and pthread waits
+//==============================================================================
+#if NEVESTRIP_INTERPOSE_C
+
+template <typename Function>
+static Function nextSymbol(const char* name)
+{
+    return reinterpret_cast<Function>(::dlsym(RTLD_NEXT, name));
+}
+
+extern "C"
+{
+    void* checkedMalloc(size_t size)                    { check("malloc"); return realMalloc(size); }
+    void* checkedCalloc(size_t count, size_t size)      { check("calloc"); return realCalloc(count, size); }
+    void* checkedRealloc(void* p, size_t size)          { check("realloc"); return realRealloc(p, size); }
+    void checkedFree(void* p)                           { if (p != nullptr) check("free"); realFree(p); }
+
+    int checkedPosixMemalign(void** result, size_t alignment, size_t size)
+    {
+        check("posix_memalign");
+        *result = realMemalign(alignment, size);
+        return *result != nullptr ? 0 : ENOMEM;
+    }
+
+    void* checkedAlignedAlloc(size_t alignment, size_t size)
+    {
+        check("aligned_alloc");
+        return realMemalign(alignment, size);
+    }
+
+   #if defined(__linux__)
+    // Resolved on first use (dlsym may allocate); a first use inside a
+    // realtime scope is a violation either way
+    int checkedMutexLock(pthread_mutex_t* m)
+    {
+        static auto real = nextSymbol<int (*)(pthread_mutex_t*)>("pthread_mutex_lock");
+        check("pthread_mutex_lock");
+        return real(m);
+    }
+
+    int checkedRwlockRdlock(pthread_rwlock_t* l)
+    {
+        static auto real = nextSymbol<int (*)(pthread_rwlock_t*)>("pthread_rwlock_rdlock");
+        check("pthread_rwlock_rdlock");
+        return real(l);
+    }
+
+    int checkedRwlockWrlock(pthread_rwlock_t* l)
+    {
+        static auto real = nextSymbol<int (*)(pthread_rwlock_t*)>("pthread_rwlock_wrlock");
+        check("pthread_rwlock_wrlock");
+        return real(l);
+    }
+
+    int checkedCondWait(pthread_cond_t* c, pthread_mutex_t* m)
+    {
+        static auto real = nextSymbol<int (*)(pthread_cond_t*, pthread_mutex_t*)>("pthread_cond_wait");
+        check("pthread_cond_wait");
+        return real(c, m);
+    }
+
+    int checkedCondTimedwait(pthread_cond_t* c, pthread_mutex_t* m, const struct timespec* t)
+    {
+        static auto real = nextSymbol<int (*)(pthread_cond_t*, pthread_mutex_t*, const struct timespec*)>("pthread_cond_timedwait");
+        check("pthread_cond_timedwait");
+        return real(c, m, t);
+    }
+   #else
+    int checkedMutexLock(pthread_mutex_t* m)            { check("pthread_mutex_lock"); return ::pthread_mutex_lock(m); }
+    int checkedRwlockRdlock(pthread_rwlock_t* l)        { check("pthread_rwlock_rdlock"); return ::pthread_rwlock_rdlock(l); }
+    int checkedRwlockWrlock(pthread_rwlock_t* l)        { check("pthread_rwlock_wrlock"); return ::pthread_rwlock_wrlock(l); }
+    int checkedCondWait(pthread_cond_t* c, pthread_mutex_t* m) { check("pthread_cond_wait"); return ::pthread_cond_wait(c, m); }
+    int checkedCondTimedwait(pthread_cond_t* c, pthread_mutex_t* m, const struct timespec* t)
+    {
+        check("pthread_cond_timedwait");
+        return ::pthread_cond_timedwait(c, m, t);
+    }
+   #endif
+}
+
+#if defined(__linux__)
+// Symbol preemption: definitions in the executable win over libc's
+extern "C"
+{
+    void* malloc(size_t size)                               { return checkedMalloc(size); }
+    void* calloc(size_t count, size_t size)                 { return checkedCalloc(count, size); }
+    void* realloc(void* p, size_t size)                     { return checkedRealloc(p, size); }
+    void free(void* p)                                      { checkedFree(p); }
+    int posix_memalign(void** r, size_t a, size_t size)     { return checkedPosixMemalign(r, a, size); }
+    void* aligned_alloc(size_t a, size_t size)              { return checkedAlignedAlloc(a, size); }
+    int pthread_mutex_lock(pthread_mutex_t* m)              { return checkedMutexLock(m); }
+    int pthread_rwlock_rdlock(pthread_rwlock_t* l)          { return checkedRwlockRdlock(l); }
+    int pthread_rwlock_wrlock(pthread_rwlock_t* l)          { return checkedRwlockWrlock(l); }
+    int pthread_cond_wait(pthread_cond_t* c, pthread_mutex_t* m) { return checkedCondWait(c, m); }
+    int pthread_cond_timedwait(pthread_cond_t* c, pthread_mutex_t* m, const struct timespec* t)
+    {
+        return checkedCondTimedwait(c, m, t);
+    }
+}
+#else
+// dyld interposing: calls from every other image go to the checked versions
+ #define NEVESTRIP_INTERPOSE(replacement, original) \
+    __attribute__((used)) static const struct { const void* r; const void* o; } interpose_##original \
+        __attribute__((section("__DATA,__interpose"))) = { reinterpret_cast<const void*>(&replacement), \
+                                                           reinterpret_cast<const void*>(&original) }
+
+NEVESTRIP_INTERPOSE(checkedMalloc, malloc);
+NEVESTRIP_INTERPOSE(checkedCalloc, calloc);
+NEVESTRIP_INTERPOSE(checkedRealloc, realloc);
+NEVESTRIP_INTERPOSE(checkedFree, free);
+NEVESTRIP_INTERPOSE(checkedPosixMemalign, posix_memalign);
+NEVESTRIP_INTERPOSE(checkedAlignedAlloc, aligned_alloc);
+NEVESTRIP_INTERPOSE(checkedMutexLock, pthread_mutex_lock);
+NEVESTRIP_INTERPOSE(checkedRwlockRdlock, pthread_rwlock_rdlock);
+NEVESTRIP_INTERPOSE(checkedRwlockWrlock, pthread_rwlock_wrlock);
+NEVESTRIP_INTERPOSE(checkedCondWait, pthread_cond_wait);
+NEVESTRIP_INTERPOSE(checkedCondTimedwait, pthread_cond_timedwait);
+#endif
+
+#endif
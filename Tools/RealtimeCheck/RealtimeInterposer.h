@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Allocation and lock traps for RealtimeGuard scopes
+ *
+ * Linking RealtimeInterposer.cpp into an executable replaces operator
+ * new/delete and interposes malloc, calloc, realloc, posix_memalign,
+ * aligned_alloc, free and the pthread mutex, rwlock and condition-variable
+ * waits. A call made inside a RealtimeGuard::Scope is printed to stderr
+ * with a stack trace and counted; the call itself still goes through.
+ *
+ * The C functions are interposed by symbol preemption on Linux and by
+ * __interpose on macOS; elsewhere only operator new/delete are trapped.
+ */
+namespace RealtimeInterposer
+{
+    // Violations since start-up (any thread)
+    uint64_t getNumViolations();
+
+    // Abort at the first violation, e.g. to get a core dump
+    void setAbortOnViolation(bool shouldAbort);
+}